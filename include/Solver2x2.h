@@ -19,17 +19,136 @@
 #ifndef SOLVER2X2_CXX_SOLVER2X2_H
 #define SOLVER2X2_CXX_SOLVER2X2_H
 
+#include <cstdint>
 #include <string>
+#include <vector>
+#include <future>
+#include <functional>
 
 namespace Solver2x2 {
 
+    /**
+     * The number of cubes, the indexes go from 0 to CUBES-1.
+     */
+    constexpr uint32_t CUBES = 3674160;
+
+    /**
+     * The number of depths, the cubes need from 0 to DEPTHS-1 moves.
+     */
+    constexpr int8_t DEPTHS = 12;
+
+    /**
+     * The bytes of a packed cube, 3 bits for every tile.
+     */
+    constexpr int8_t PACKED_BYTES = 9;
+
+    /**
+     * The index of a cube that is not valid.
+     */
+    constexpr uint32_t NO_CUBE = UINT32_MAX;
+
+    /**
+     * The number of corner states of the 3x3 cube, the indexes of the
+     * corner pattern database go from 0 to CORNER_STATES-1.
+     */
+    constexpr uint32_t CORNER_STATES = 88179840;
+
+    /**
+     * The formats of the exported cubes.
+     */
+    enum Format : int8_t{
+        BINARY_FORMAT = 0,
+        CSV_FORMAT = 1
+    };
+
+    /**
+     * The profile of the generation of the solver.
+     * Top down a probe is a check of a son in the explored cubes,
+     * a hit is a probe of a son already explored.
+     * Bottom up a probe is a check of a parent in the frontier,
+     * a hit is a parent found in the frontier, one for every son.
+     * estimatedPeakBytes is computed from the sizes of the tree, the
+     * solutions and the largest temporary buffers, it is not measured.
+     */
+    struct GenerationReport{
+        double seconds[DEPTHS];
+        uint64_t probes[DEPTHS];
+        uint64_t hits[DEPTHS];
+        uint32_t found[DEPTHS];
+        bool bottomUp[DEPTHS];
+        double total;
+        size_t treeBytes;
+        size_t scrambleBytes;
+        size_t estimatedPeakBytes;
+        bool valid;
+    };
+
+    /**
+     * The tables used to solve the cubes:
+     * FULL_BACKEND the solutions, 29 MB, a read for every cube.
+     * DEPTH_BACKEND the depths in 4 bits, 1.8 MB, 9 reads for every move.
+     * MOD3_BACKEND the depths modulo 3 in 2 bits, 0.9 MB, 9 reads for every move.
+     * MEET_BACKEND the cubes within 6 moves, 0.5 MB, the other moves are searched.
+     * BLOCK_BACKEND the solutions compressed in blocks, 12 MB, a block is read for every
+     * cube and the last ones are kept by every thread. loadBackend maps its file.
+     */
+    enum Backend : int8_t{
+        FULL_BACKEND = 0,
+        DEPTH_BACKEND = 1,
+        MOD3_BACKEND = 2,
+        MEET_BACKEND = 3,
+        BLOCK_BACKEND = 4
+    };
+
+    /**
+     * The memory and the time of a table.
+     */
+    struct BackendStats{
+        Backend backend;
+        size_t bytes;
+        double nanos;
+    };
+
+    /**
+     * The costs of the moves, to choose among the optimal solutions of a cube
+     * the easiest one. The moves are F1 F2 F3 R1 R2 R3 U1 U2 U3, in this order.
+     * The cost of a solution is the sum of move of every move and of pair of
+     * every move after the previous one, pair[previous][move], for example
+     * to make a regrip expensive. A solution costs at most 65534.
+     */
+    struct MoveCosts{
+        uint16_t move[9];
+        uint16_t pair[9][9];
+    };
+
     /**
      * This is the initializer for the solver. It takes around 3 seconds for
      * a i5 processor. It also needs around 150 MB, but after the initialization
      * part of the memory will be deallocated automatically. It will remain 15 MB
-     * used.
+     * used. The number of cubes of every depth is checked, also in
+     * the release builds.
+     *
+     * @return              : True if every depth has the right number of cubes,
+     *                        otherwise the table is not replaced.
      */
-    void init();
+    bool init();
+
+    /**
+     * Initialize the solver and profile the generation.
+     *
+     * @param report        : The report to fill.
+     * @return              : True if every depth has the right number of cubes,
+     *                        otherwise the table is not replaced.
+     */
+    bool init(GenerationReport& report);
+
+    /**
+     * Convert a report into a table, a line for every depth.
+     *
+     * @param report        : The report of init.
+     * @return              : The report in text.
+     */
+    std::string reportText(const GenerationReport& report);
 
     /**
      * This is used to deallocate the solver.
@@ -52,6 +171,120 @@ namespace Solver2x2 {
      */
     bool loadFile(const std::string& name);
 
+    /**
+     * Write the solver into a file ordered by depth, half the size
+     * of writeFile. It can be read with loadDepthFile.
+     *
+     * @param name          : The name of the file.
+     * @return              : True if the file is written.
+     */
+    bool writeDepthFile(const std::string& name);
+
+    /**
+     * Read the solver from a file ordered by depth. The depths are read in
+     * background, from the shortest, and every depth can be used as soon as
+     * it is read. A solve of a cube not read yet waits its depth.
+     * If the file does not exist, the solver is initialized and written.
+     * If the records are broken the table is generated again in background
+     * and loadFailed returns true.
+     *
+     * @param name          : The name of the file.
+     * @return              : True if the file is correct or written.
+     */
+    bool loadDepthFile(const std::string& name);
+
+    /**
+     * Get the number of depths ready, 12 when the solver is ready.
+     *
+     * @return              : The cubes that need less moves can be solved, 0 without solver.
+     */
+    int8_t loadedDepths();
+
+    /**
+     * Check if the last file ordered by depth was broken, its table
+     * is generated instead of read.
+     *
+     * @return              : True if the table in use was not read from the file.
+     */
+    bool loadFailed();
+
+    /**
+     * Change the table used to solve the cubes. The small tables free the
+     * solutions, the functions that need all of them (exportCubes, adviseBackend,
+     * setMoveCosts and the files) generate them again for the call and free
+     * them at the end. The cubes grouped by depth (histogram, countAtDepth,
+     * stateAtDepth and randomAtDepth) are built once for every table, 14 MB.
+     *
+     * @param backend       : The table.
+     * @return              : True if its done correctly.
+     */
+    bool setBackend(Backend backend);
+
+    /**
+     * Get the table used to solve the cubes.
+     *
+     * @return              : The table.
+     */
+    Backend currentBackend();
+
+    /**
+     * Get costs for the right hand: R and U cost 1, F costs 3, a half turn costs
+     * one more, and a regrip, from F to R or U and back, costs 2.
+     *
+     * @return              : The costs.
+     */
+    MoveCosts ergonomicCosts();
+
+    /**
+     * Choose again the solution of every cube: among its optimal solutions the one
+     * with the least cost, the first move on a tie. The solutions stay in the full
+     * table with the same solve time, the table is used like loadFile and writeFile
+     * saves it. BLOCK_BACKEND keeps the same solutions, the other small tables choose
+     * their own moves.
+     *
+     * @param costs         : The costs of the moves.
+     * @param threads       : The threads of the choice, 0 for the number of cores.
+     * @return              : True if its done correctly.
+     */
+    bool setMoveCosts(const MoveCosts& costs, uint32_t threads = 0);
+
+    /**
+     * Write the table used to solve the cubes into a file.
+     *
+     * @param name          : The name of the file.
+     * @return              : True if the file is written.
+     */
+    bool writeBackend(const std::string& name);
+
+    /**
+     * Read a table from a file written by writeBackend. If the file does not
+     * exist, the table is generated and written.
+     *
+     * @param backend       : The table.
+     * @param name          : The name of the file.
+     * @return              : True if its done correctly.
+     */
+    bool loadBackend(Backend backend, const std::string& name);
+
+    /**
+     * Measure the memory and the time of a solve of every table on this machine.
+     *
+     * @param cubes         : The number of random cubes to solve.
+     * @return              : The stats of every table.
+     */
+    std::vector<BackendStats> benchmarkBackends(uint32_t cubes = 100000);
+
+    /**
+     * Choose a table with the benchmark: the smallest one in the time, or
+     * without time the fastest one in the memory. If no table fits the memory,
+     * the smallest one.
+     *
+     * @param maxBytes      : The max memory of the table.
+     * @param maxNanos      : The max time of a solve in nanoseconds, 0 for no limit.
+     * @return              : The table to use with setBackend.
+     */
+    Backend adviseBackend(size_t maxBytes, double maxNanos = 0);
+
     /**
      * Solve the cube.
      *
@@ -73,6 +306,343 @@ namespace Solver2x2 {
      */
     std::string solve(const std::string& cube);
 
+    /**
+     * Solve a cube with some unknown tiles, given with '?'.
+     * The other tiles are given with the colors (Y W B G R O) or with
+     * the faces (U R F D L B), the faces if a tile is U, F, D or L.
+     * It returns the shortest solution among all the cubes that
+     * agree with the known tiles.
+     *
+     * @param cube          : The cube string.
+     * @param matched       : The number of cubes that agree with the known tiles.
+     * @return              : The string with the solving scramble, "Error" if
+     *                        no cube agrees.
+     */
+    std::string solveMasked(const std::string& cube, uint32_t& matched);
+
+    /**
+     * Generate a goal table: the shortest scramble from every cube to the nearest cube
+     * of a set, for example the cubes with the first layer solved or the solved cube
+     * with any U turn. The goal cubes are given like in the solve function and can have
+     * unknown tiles with '?', like in solveMasked, then all the cubes that agree are goals.
+     * Many goal tables can be used at once, 29 MB each, a table with the same name is replaced.
+     *
+     * @param name          : The name of the table.
+     * @param goals         : The goal cubes.
+     * @return              : True if the table is generated, false if a cube is not valid.
+     */
+    bool makeGoal(const std::string& name, const std::vector<std::string>& goals);
+
+    /**
+     * Generate a goal table from a condition, it is checked on all the cubes.
+     *
+     * @param name          : The name of the table.
+     * @param isGoal        : True for the goal cubes, the cube is given like in the solve function.
+     * @return              : True if the table is generated, false if no cube is a goal.
+     */
+    bool makeGoal(const std::string& name, const std::function<bool(const std::string&)>& isGoal);
+
+    /**
+     * Write a goal table into a file.
+     *
+     * @param name          : The name of the table.
+     * @param file          : The name of the file.
+     * @return              : True if the file is written.
+     */
+    bool writeGoal(const std::string& name, const std::string& file);
+
+    /**
+     * Read a goal table written by writeGoal.
+     *
+     * @param name          : The name of the table.
+     * @param file          : The name of the file.
+     * @return              : True if the file is read.
+     */
+    bool loadGoal(const std::string& name, const std::string& file);
+
+    /**
+     * Remove a goal table.
+     *
+     * @param name          : The name of the table.
+     */
+    void removeGoal(const std::string& name);
+
+    /**
+     * Get the names of the goal tables.
+     *
+     * @return              : The names, in order.
+     */
+    std::vector<std::string> goalNames();
+
+    /**
+     * Find the shortest scramble from a cube to the nearest cube of a goal table.
+     *
+     * @param cube          : The cube string.
+     * @param goal          : The name of the table.
+     * @return              : The string with the scramble, "Error" if the cube is
+     *                        not valid or there is no table.
+     */
+    std::string solveGoal(const std::string& cube, const std::string& goal);
+
+    /**
+     * Find the shortest scramble from a cube to the nearest goal of many tables.
+     *
+     * @param cube          : The cube string.
+     * @param goals         : The names of the tables, empty for all of them.
+     * @param reached       : The name of the table of the goal reached.
+     * @return              : The string with the scramble, "Error" if the cube is
+     *                        not valid or there is no table.
+     */
+    std::string solveGoal(const std::string& cube, const std::vector<std::string>& goals, std::string& reached);
+
+    /**
+     * Find the shortest scramble that changes a cube into another one.
+     * Both cubes are given like in the solve function.
+     *
+     * @param from          : The starting cube.
+     * @param to            : The target cube.
+     * @return              : The string with the scramble, "Error" if
+     *                        a cube is not valid or without solver.
+     */
+    std::string solveTo(const std::string& from, const std::string& to);
+
+    /**
+     * Solve a batch of cubes.
+     * The cubes are converted into indexes first, then optionally
+     * sorted to read the solver memory in order, and finally looked
+     * up with prefetching. Its faster than solving one cube at a time
+     * for big batches.
+     *
+     * @param cubes         : The cube strings.
+     * @param sorted        : Sort the lookups, useful for very big batches.
+     * @return              : The strings with the solving scrambles,
+     *                        "Error" for the invalid cubes.
+     */
+    std::vector<std::string> solve(const std::vector<std::string>& cubes, bool sorted = false);
+
+    /**
+     * Pack the cubes in PACKED_BYTES each, the tiles become the faces given by
+     * the DBL corner, in 3 bits (u r f d l b from 0 to 5). The tile i is in the
+     * bits from 3*i, the first byte has the lowest bits. The cubes with wrong
+     * colors have all the bits set.
+     *
+     * @param cubes         : The cube strings.
+     * @param packed        : The array to store the cubes, of PACKED_BYTES for every cube.
+     * @return              : The number of cubes packed.
+     */
+    uint32_t packCubes(const std::vector<std::string>& cubes, uint8_t packed[]);
+
+    /**
+     * Unpack the cubes, with the colors of the solved cube (YOGWRB).
+     *
+     * @param packed        : The packed cubes, of PACKED_BYTES each.
+     * @param n             : The number of cubes.
+     * @return              : The cube strings, "Error" for the wrong ones.
+     */
+    std::vector<std::string> unpackCubes(const uint8_t packed[], size_t n);
+
+    /**
+     * Convert the cubes into their indexes, from 0 to CUBES-1, a cube in 22 bits.
+     *
+     * @param cubes         : The cube strings.
+     * @return              : The indexes, NO_CUBE for the invalid cubes.
+     */
+    std::vector<uint32_t> toIndexes(const std::vector<std::string>& cubes);
+
+    /**
+     * Solve a batch of packed cubes, like the solve of the strings
+     * but without reading the colors.
+     *
+     * @param packed        : The packed cubes, of PACKED_BYTES each.
+     * @param n             : The number of cubes.
+     * @param sorted        : Sort the lookups, useful for very big batches.
+     * @return              : The strings with the solving scrambles,
+     *                        "Error" for the invalid cubes.
+     */
+    std::vector<std::string> solvePacked(const uint8_t packed[], size_t n, bool sorted = false);
+
+    /**
+     * Solve a batch of cubes given with their indexes.
+     *
+     * @param cubes         : The indexes of the cubes.
+     * @param sorted        : Sort the lookups, useful for very big batches.
+     * @return              : The strings with the solving scrambles,
+     *                        "Error" for the indexes out of range.
+     */
+    std::vector<std::string> solveIndexes(const std::vector<uint32_t>& cubes, bool sorted = false);
+
+    /**
+     * Apply a sequence of moves to a batch of cubes given with their indexes, for
+     * analysis over many cubes. It uses the AVX-512 or AVX2 gathers if the cpu
+     * supports them, the table of the solver is not needed.
+     *
+     * @param cubes         : The indexes of the cubes, changed. The indexes out of range stay.
+     * @param n             : The number of cubes.
+     * @param sequence      : The moves, in the notation of optimize.
+     * @return              : True if the sequence is valid, otherwise the cubes do not change.
+     */
+    bool applyMoves(uint32_t cubes[], size_t n, const std::string& sequence);
+
+    /**
+     * Get the number of moves to solve the cube, without
+     * building the solution.
+     *
+     * @param cube          : The cube string.
+     * @return              : The distance from the solved cube, -1 if
+     *                        the cube is not valid.
+     */
+    int8_t distance(const std::string& cube);
+
+    /**
+     * Get the number of moves to solve a batch of cubes.
+     *
+     * @param cubes         : The cube strings.
+     * @return              : The distances, -1 for the invalid cubes.
+     */
+    std::vector<int8_t> distance(const std::vector<std::string>& cubes);
+
+    /**
+     * Start the threads of the async solves. The cubes that arrive together are
+     * solved in a batch: a batch waits until it is full or its first cube waited
+     * the flush time, then a worker solves every different cube of it once.
+     * It returns false if the threads are already started, stopAsync stops them.
+     *
+     * @param maxBatch      : The most cubes of a batch.
+     * @param flushMicros   : The most microseconds a cube waits the other ones.
+     * @param threads       : The number of workers, 0 for the number of cores.
+     * @return              : True if the threads are started.
+     */
+    bool startAsync(uint32_t maxBatch = 1024, uint32_t flushMicros = 200, uint32_t threads = 0);
+
+    /**
+     * Solve the cubes already given and stop the threads of the async solves.
+     * A solveAsync called during the stop, also by a callback, gets "Error".
+     */
+    void stopAsync();
+
+    /**
+     * Solve a cube in background, the threads are started with the
+     * default values at the first call.
+     *
+     * @param cube          : The cube string.
+     * @return              : The future solving scramble, "Error" if the cube is not valid
+     *                        or the threads are stopping.
+     */
+    std::future<std::string> solveAsync(const std::string& cube);
+
+    /**
+     * Solve a cube in background, the callback is called by a worker,
+     * or at once with "Error" if the threads are stopping.
+     *
+     * @param cube          : The cube string.
+     * @param callback      : The function that receives the solving scramble.
+     */
+    void solveAsync(const std::string& cube, std::function<void(const std::string&)> callback);
+
+    /**
+     * Generate the corner pattern database of the 3x3 cube and write it into
+     * a file of 42 MB. It has the moves to solve the 8 corners with all the
+     * 18 face moves, for the heuristic of a 3x3 solver. The generated table
+     * is also used by cornerDepth.
+     *
+     * @param name          : The name of the file.
+     * @param threads       : The threads of the generation, 0 for the number of cores.
+     * @return              : True if the table is generated and written.
+     */
+    bool writeCornerTable(const std::string& name, uint32_t threads = 0);
+
+    /**
+     * Map the corner pattern database in memory, the pages are read from
+     * the disk when they are used. If the file is missing or broken the
+     * table is generated and written.
+     *
+     * @param name          : The name of the file.
+     * @param threads       : The threads of the generation, 0 for the number of cores.
+     * @return              : True if the table is ready.
+     */
+    bool loadCornerTable(const std::string& name, uint32_t threads = 0);
+
+    /**
+     * Unmap the corner pattern database.
+     */
+    void unloadCornerTable();
+
+    /**
+     * Compute the index of the corners of a 3x3 cube. The corners are
+     * UFR UFL UBL UBR DFR DFL DBL DBR, from 0 to 7, the twists are 0 for the
+     * U or D sticker on U or D, 1 clockwise and 2 anticlockwise.
+     *
+     * @param perm          : The corner in every position.
+     * @param ori           : The twist of every position.
+     * @return              : The index, NO_CUBE if the corners are not valid.
+     */
+    uint32_t cornerIndex(const int8_t perm[8], const int8_t ori[8]);
+
+    /**
+     * Apply a move to a corner index, the moves are F R U B L D, 3 for every
+     * face: clockwise, half turn and anticlockwise. It needs no table.
+     *
+     * @param idx           : The corner index.
+     * @param move          : The move, from 0 to 17.
+     * @return              : The new index, NO_CUBE if the arguments are not valid.
+     */
+    uint32_t cornerMove(uint32_t idx, int8_t move);
+
+    /**
+     * Get the moves to solve the corners of a 3x3 cube.
+     *
+     * @param idx           : The corner index.
+     * @return              : The moves, -1 if the table is not loaded or the index is not valid.
+     */
+    int8_t cornerDepth(uint32_t idx);
+
+    /**
+     * Get the moves to solve the corners of many 3x3 cubes. The table is read
+     * with the next states already requested to the memory.
+     *
+     * @param idx           : The corner indexes.
+     * @param res           : The moves, -1 for the indexes not valid or no table.
+     * @param n             : The number of indexes.
+     */
+    void cornerDepth(const uint32_t idx[], int8_t res[], size_t n);
+
+    /**
+     * Count all the cubes for every number of moves to solve them.
+     * The index is the number of moves.
+     *
+     * @return              : The counts, from 0 to 11 moves.
+     */
+    std::vector<uint32_t> histogram();
+
+    /**
+     * Count the cubes of a batch for every number of moves to solve them.
+     * The invalid cubes are not counted.
+     *
+     * @param cubes         : The cube strings.
+     * @return              : The counts, from 0 to 11 moves.
+     */
+    std::vector<uint32_t> histogram(const std::vector<std::string>& cubes);
+
+    /**
+     * Export the cubes of a range of indexes with their solutions.
+     * The cubes are formatted in parallel and the file is always the
+     * same for the same range, so a big export can be split in more files.
+     *
+     * The binary format has 32 bytes for every cube: the 24 colors of the
+     * tiles and the solution in 8 bytes little endian. The first 4 bits are
+     * the number of moves, then every 4 bits there is a move, in the order
+     * F1 F2 F3 R1 R2 R3 U1 U2 U3.
+     * The CSV format has a line for every cube: index,tiles,moves,solution.
+     *
+     * @param name          : The name of the file.
+     * @param format        : The format of the file.
+     * @param begin         : The index of the first cube.
+     * @param end           : The index after the last cube.
+     * @param threads       : The number of threads, 0 to use all the cpus.
+     * @return              : True if its done correctly, false if not.
+     */
+    bool exportCubes(const std::string& name, Format format, uint32_t begin = 0, uint32_t end = CUBES, uint32_t threads = 0);
+
     /**
      * Generate a random cube.
      *
@@ -80,6 +650,48 @@ namespace Solver2x2 {
      */
     std::string random();
 
+    /**
+     * Check the solutions of all the cubes, applying the moves on the coordinates.
+     * A solution is right if it reaches the solved cube, every move lowers the
+     * number of moves by one and no move of the cube lowers it by more than one,
+     * so the solution is also the shortest one. The table used by the solves is
+     * checked as it is, also a small table or a table read from a file.
+     *
+     * @param threads       : The number of threads, 0 for all the cores.
+     * @return              : The number of wrong solutions, 0 if the solver is right,
+     *                        all the cubes without solver.
+     */
+    uint32_t verify(uint32_t threads = 0);
+
+    /**
+     * Get the number of cubes that need a number of moves to be solved.
+     *
+     * @param depth         : The number of moves.
+     * @return              : The number of cubes.
+     */
+    uint32_t countAtDepth(int8_t depth);
+
+    /**
+     * Get a cube that needs a number of moves to be solved.
+     * The cubes of a depth go from 0 to countAtDepth(depth)-1,
+     * so they can be iterated.
+     *
+     * @param depth         : The number of moves.
+     * @param i             : The position of the cube in the depth.
+     * @return              : The cube, "Error" if it does not exist.
+     */
+    std::string stateAtDepth(int8_t depth, uint32_t i);
+
+    /**
+     * Generate a random cube that needs a number of moves to be solved.
+     * Its a single draw, also for the rare depths.
+     *
+     * @param depth         : The number of moves.
+     * @param atLeast       : True to get a cube with at least depth moves.
+     * @return              : The random cube, "Error" if the depth does not exist.
+     */
+    std::string randomAtDepth(int8_t depth, bool atLeast = false);
+
     /**
      * Run all the tests of the code to check if its run correctly.
      */
@@ -100,6 +712,106 @@ namespace Solver2x2 {
      * @return              : The cube created.
      */
     std::string fromScramble(const std::string& scramble);
+
+    /**
+     * Find the shortest scramble that gives the same cube of a sequence
+     * of moves, ignoring the rotation of the whole cube.
+     * The sequence is in the standard notation (R R' R2 with the faces
+     * U R F D L B and the rotations x y z), the solver notation (R1 R3 R2)
+     * is accepted too. It has no limit of length.
+     *
+     * @param sequence      : The sequence of moves.
+     * @return              : The optimal scramble in the solver notation,
+     *                        "Error" if the sequence is not valid or without solver.
+     */
+    std::string optimize(const std::string& sequence);
+
+    /**
+     * CubeSession class.
+     * It follows a cube move by move, keeping only its coordinates.
+     * Every move is applied in constant time, so the solution can be
+     * asked after every move without converting the cube into a string.
+     * The solver must be initialized to get the distance and the solution.
+     */
+    class CubeSession{
+    private:
+
+        ///corner orient
+        uint16_t ori;
+
+        ///corner perm
+        uint16_t perm;
+
+        ///moves applied, used to undo them
+        std::vector<int8_t> history;
+
+    public:
+
+        /**
+         * Start from the solved cube.
+         */
+        CubeSession();
+
+        /**
+         * Start from a cube, given like in the solve function.
+         * The history is cleared.
+         *
+         * @param cube          : The cube string.
+         * @return              : True if the cube is valid, false if not.
+         */
+        bool setCube(const std::string& cube);
+
+        /**
+         * Reset the session to the solved cube.
+         */
+        void reset();
+
+        /**
+         * Apply a move.
+         * The moves are in the order F1 F2 F3 R1 R2 R3 U1 U2 U3.
+         *
+         * @param move          : The move, from 0 to 8.
+         * @return              : True if its done correctly, false if not.
+         */
+        bool move(int8_t move);
+
+        /**
+         * Apply a move given as a string, like "R3".
+         *
+         * @param move          : The move string.
+         * @return              : True if its done correctly, false if not.
+         */
+        bool move(const std::string& move);
+
+        /**
+         * Undo the last move.
+         *
+         * @return              : True if its done correctly, false if there
+         *                        are no moves to undo.
+         */
+        bool undo();
+
+        /**
+         * Get the number of moves to solve the cube.
+         *
+         * @return              : The distance from the solved cube, -1 without solver.
+         */
+        int8_t distance() const;
+
+        /**
+         * Solve the cube of the session.
+         *
+         * @return              : The string with the solving scramble, "Error" without solver.
+         */
+        std::string solve() const;
+
+        /**
+         * Get the number of moves applied.
+         *
+         * @return              : The number of moves.
+         */
+        size_t size() const;
+    };
 }
 
 #endif //SOLVER2X2_CXX_SOLVER2X2_H
@@ -0,0 +1,113 @@
+/**
+ * This is the C interface of the Solver for 2x2 cubes.
+ * It can be called from every language with a C FFI.
+ * The cubes are packed one after the other, 24 chars each,
+ * in the same order of Solver2x2.h, without terminator.
+ * The batch functions cross the interface once for all the
+ * cubes and write into buffers owned by the caller.
+ *
+ * The moves are numbers:
+ *
+ *  0 F1, 1 F2, 2 F3, 3 R1, 4 R2, 5 R3, 6 U1, 7 U2, 8 U3
+ */
+
+#ifndef SOLVER2X2_CXX_SOLVER2X2_C_H
+#define SOLVER2X2_CXX_SOLVER2X2_C_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The chars of a packed cube.
+ */
+#define S2X2_TILES 24
+
+/**
+ * The max moves of a solution, the moves of a cube in the buffer.
+ */
+#define S2X2_MAX_MOVES 11
+
+/**
+ * The move written after the end of a solution.
+ */
+#define S2X2_NO_MOVE 255
+
+/**
+ * The length of a cube that is not valid.
+ */
+#define S2X2_ERROR (-1)
+
+/**
+ * Opaque solver, every solver has its own table.
+ */
+typedef struct S2x2Solver S2x2Solver;
+
+/**
+ * Create a solver. With a name the table is read from the file,
+ * if the file does not exist the table is generated and written.
+ * Without a name (NULL) the table is only generated.
+ *
+ * @param name          : The name of the file or NULL.
+ * @return              : The solver, NULL if it can not be created.
+ */
+S2x2Solver* s2x2_create(const char* name);
+
+/**
+ * Destroy a solver.
+ *
+ * @param solver        : The solver, it can be NULL.
+ */
+void s2x2_destroy(S2x2Solver* solver);
+
+/**
+ * Write the table of a solver into a file.
+ *
+ * @param solver        : The solver.
+ * @param name          : The name of the file.
+ * @return              : 1 if the file is written, 0 otherwise.
+ */
+int32_t s2x2_write(const S2x2Solver* solver, const char* name);
+
+/**
+ * Solve a batch of cubes.
+ * The moves of the cube i are moves[i*S2X2_MAX_MOVES] to
+ * moves[i*S2X2_MAX_MOVES+lengths[i]-1], the others are S2X2_NO_MOVE.
+ *
+ * @param solver        : The solver.
+ * @param cubes         : The packed cubes, n*S2X2_TILES chars.
+ * @param n             : The number of cubes.
+ * @param moves         : The buffer of the moves, n*S2X2_MAX_MOVES bytes.
+ * @param lengths       : The buffer of the lengths, n bytes, S2X2_ERROR for a wrong cube.
+ * @return              : The number of valid cubes, (uint32_t)S2X2_ERROR without
+ *                        solver or buffers or if the memory is not enough.
+ */
+uint32_t s2x2_solve_batch(const S2x2Solver* solver, const char* cubes, uint32_t n, uint8_t* moves, int8_t* lengths);
+
+/**
+ * Get the number of moves to solve a batch of cubes.
+ *
+ * @param solver        : The solver.
+ * @param cubes         : The packed cubes, n*S2X2_TILES chars.
+ * @param n             : The number of cubes.
+ * @param lengths       : The buffer of the lengths, n bytes, S2X2_ERROR for a wrong cube.
+ * @return              : The number of valid cubes, (uint32_t)S2X2_ERROR without
+ *                        solver or buffers or if the memory is not enough.
+ */
+uint32_t s2x2_distance_batch(const S2x2Solver* solver, const char* cubes, uint32_t n, int8_t* lengths);
+
+/**
+ * Get the name of a move, like "R1".
+ *
+ * @param move          : The move.
+ * @return              : The name, "" if the move does not exist.
+ */
+const char* s2x2_move_name(uint8_t move);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SOLVER2X2_CXX_SOLVER2X2_C_H
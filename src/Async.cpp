@@ -0,0 +1,209 @@
+/**
+ * This file contains the class Async.
+ * It solves the cubes of many threads in batches.
+ */
+
+#include "Async.h"
+#include "Explore.h"
+#include "Tiles.h"
+#include "DepthFile.h"
+
+namespace Solver2x2{
+
+    //start the threads, the queue starts with an empty node
+    Async::Async(batch_solve_f solveBatch, uint32_t maxBatch, uint32_t flushMicros, uint32_t threads) :
+            solveBatch(solveBatch), maxBatch(maxBatch == 0 ? 1 : maxBatch), flush(flushMicros){
+        uint32_t i;
+
+        tail = new Request();
+        head.store(tail);
+
+        collector = std::thread(&Async::collect, this);
+
+        for(i = 0; i < (threads == 0 ? 1 : threads); i++)
+            workers.emplace_back(&Async::work, this);
+    }
+
+    //solve the rest and stop the threads
+    Async::~Async(){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+
+        arrived.notify_all();
+        collector.join();
+
+        for(std::thread& worker : workers)
+            worker.join();
+
+        delete tail;
+    }
+
+    //push a request, the collector is woken by the first one and by a full batch
+    void Async::push(Request* request){
+        Request* prev;
+        uint32_t n;
+
+        //counted before it can be taken
+        n = pending.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+        prev = head.exchange(request, std::memory_order_acq_rel);
+        prev->next.store(request, std::memory_order_release);
+
+        if(n == 1 || n == maxBatch){
+            std::lock_guard<std::mutex> lock(mutex);
+            arrived.notify_one();
+        }
+    }
+
+    //take the job of the node after the empty one, that becomes the empty one
+    bool Async::pop(Job& job){
+        Request* next = tail->next.load(std::memory_order_acquire);
+
+        if(next == nullptr)
+            return false;
+
+        job = std::move(next->job);
+
+        delete tail;
+        tail = next;
+
+        return true;
+    }
+
+    //make the batches
+    void Async::collect(){
+        std::vector<Job> batch;
+        Job job;
+
+        for(;;){
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+
+                arrived.wait(lock, [&]{ return pending.load() > 0 || stop.load(); });
+
+                if(pending.load() == 0)
+                    break;
+
+                //the first cube waits at most the flush time
+                arrived.wait_for(lock, flush, [&]{ return pending.load() >= maxBatch || stop.load(); });
+            }
+
+            //a request counted but not linked yet goes in the next batch
+            while(batch.size() < maxBatch && pop(job))
+                batch.push_back(std::move(job));
+
+            pending.fetch_sub((uint32_t)batch.size(), std::memory_order_acq_rel);
+
+            if(batch.empty())
+                continue;
+
+            {
+                std::lock_guard<std::mutex> lock(batchMutex);
+                batches.push_back(std::move(batch));
+            }
+
+            batchReady.notify_one();
+            batch = std::vector<Job>();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(batchMutex);
+            batchEnd = true;
+        }
+
+        batchReady.notify_all();
+    }
+
+    //solve the batches
+    void Async::work(){
+        std::vector<Job> batch;
+
+        for(;;){
+            {
+                std::unique_lock<std::mutex> lock(batchMutex);
+
+                batchReady.wait(lock, [&]{ return !batches.empty() || batchEnd; });
+
+                if(batches.empty())
+                    return;
+
+                batch = std::move(batches.front());
+                batches.pop_front();
+            }
+
+            solve(batch);
+        }
+    }
+
+    //convert, sort, solve every index once and answer
+    void Async::solve(std::vector<Job>& batch){
+        std::vector<uint32_t> idx, pos, unique;
+        std::vector<uint64_t> res;
+        std::vector<std::string> text, sols(batch.size(), "Error");
+        uint32_t i, j;
+
+        idx.reserve(batch.size());
+        pos.reserve(batch.size());
+
+        for(i = 0; i < batch.size(); i++){
+            Tiles tiles(batch[i].cube);
+
+            if(tiles.getError() != NO_ERROR)
+                continue;
+
+            idx.push_back(Explore::Scramble::index(tiles.getOri(), tiles.getPerm()));
+            pos.push_back(i);
+        }
+
+        Explore::Scramble::sort(idx.data(), pos.data(), (uint32_t)idx.size());
+
+        //the same cubes are near after the sort
+        for(i = 0; i < idx.size(); i++)
+            if(unique.empty() || unique.back() != idx[i])
+                unique.push_back(idx[i]);
+
+        res.resize(unique.size());
+        solveBatch(unique.data(), res.data(), (uint32_t)unique.size());
+
+        text.reserve(unique.size());
+
+        for(i = 0; i < unique.size(); i++)
+            text.push_back(res[i] == NOT_LOADED ? "Error" : Explore::convert(res[i]));
+
+        for(i = 0, j = 0; i < idx.size(); i++){
+            if(unique[j] != idx[i])
+                j++;
+
+            sols[pos[i]] = text[j];
+        }
+
+        for(i = 0; i < batch.size(); i++){
+            if(batch[i].callback)
+                batch[i].callback(sols[i]);
+            else
+                batch[i].promise.set_value(sols[i]);
+        }
+    }
+
+    //solve with a future
+    std::future<std::string> Async::solve(const std::string& cube){
+        auto* request = new Request();
+        std::future<std::string> res = request->job.promise.get_future();
+
+        request->job.cube = cube;
+        push(request);
+
+        return res;
+    }
+
+    //solve with a callback
+    void Async::solve(const std::string& cube, std::function<void(const std::string&)> callback){
+        auto* request = new Request();
+
+        request->job.cube = cube;
+        request->job.callback = std::move(callback);
+        push(request);
+    }
+}
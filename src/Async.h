@@ -0,0 +1,160 @@
+/**
+ * This file contains the class Async.
+ * It solves the cubes of many threads in batches:
+ *
+ * - the cubes are pushed into a lock-free queue, with many producers
+ *   and a single consumer, the collector;
+ * - the collector waits until a batch is full or the oldest cube
+ *   waited the flush time, then it gives the batch to the workers;
+ * - a worker converts all the cubes, sorts the indexes, solves every
+ *   different index once and gives the solution to all its cubes.
+ */
+
+#ifndef SOLVER2X2_CXX_ASYNC_H
+#define SOLVER2X2_CXX_ASYNC_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <future>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace Solver2x2{
+
+    /**
+     * The function that solves the indexes of a batch.
+     */
+    typedef void (*batch_solve_f)(const uint32_t idx[], uint64_t res[], uint32_t n);
+
+    /**
+     * Class Async
+     * The queue, the collector and the workers.
+     */
+    class Async{
+    private:
+
+        /**
+         * A cube to solve and where to give the solution.
+         */
+        struct Job{
+            std::string cube;
+            std::promise<std::string> promise;
+            std::function<void(const std::string&)> callback;
+        };
+
+        /**
+         * The node of the queue.
+         */
+        struct Request{
+            std::atomic<Request*> next{nullptr};
+            Job job;
+        };
+
+        ///the solve of the indexes
+        const batch_solve_f solveBatch;
+
+        ///the most cubes of a batch
+        const uint32_t maxBatch;
+
+        ///the most time a cube waits the batch
+        const std::chrono::microseconds flush;
+
+        ///the last request pushed, changed by the producers
+        std::atomic<Request*> head;
+
+        ///the first node, its job is already taken, changed only by the collector
+        Request* tail;
+
+        ///the requests pushed and not taken
+        std::atomic<uint32_t> pending{0};
+
+        ///true to end, after all the requests
+        std::atomic<bool> stop{false};
+
+        ///the collector waits the requests
+        std::mutex mutex;
+        std::condition_variable arrived;
+
+        ///the batches for the workers
+        std::deque<std::vector<Job>> batches;
+        std::mutex batchMutex;
+        std::condition_variable batchReady;
+        bool batchEnd = false;
+
+        ///the threads
+        std::thread collector;
+        std::vector<std::thread> workers;
+
+        /**
+         * Push a request, from any thread.
+         *
+         * @param request   : The request.
+         */
+        void push(Request* request);
+
+        /**
+         * Take the oldest job, only from the collector.
+         *
+         * @param job       : The job taken.
+         * @return          : False if the queue is empty.
+         */
+        bool pop(Job& job);
+
+        /**
+         * Make the batches, run by the collector.
+         */
+        void collect();
+
+        /**
+         * Solve the batches, run by the workers.
+         */
+        void work();
+
+        /**
+         * Solve a batch and answer its jobs.
+         *
+         * @param batch     : The jobs.
+         */
+        void solve(std::vector<Job>& batch);
+
+    public:
+
+        /**
+         * Start the collector and the workers.
+         *
+         * @param solveBatch    : The solve of the indexes.
+         * @param maxBatch      : The most cubes of a batch.
+         * @param flushMicros   : The most microseconds a cube waits the batch.
+         * @param threads       : The number of workers.
+         */
+        Async(batch_solve_f solveBatch, uint32_t maxBatch, uint32_t flushMicros, uint32_t threads);
+
+        /**
+         * Solve all the requests and stop the threads.
+         */
+        ~Async();
+
+        /**
+         * Solve a cube in a batch.
+         *
+         * @param cube      : The cube string.
+         * @return          : The future solution, "Error" if the cube is not valid.
+         */
+        std::future<std::string> solve(const std::string& cube);
+
+        /**
+         * Solve a cube in a batch, the callback is called by a worker.
+         *
+         * @param cube      : The cube string.
+         * @param callback  : The function that receives the solution.
+         */
+        void solve(const std::string& cube, std::function<void(const std::string&)> callback);
+    };
+}
+
+#endif //SOLVER2X2_CXX_ASYNC_H
@@ -0,0 +1,643 @@
+/**
+ * This file contains the tables used to solve the cubes.
+ */
+
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include "Backend.h"
+
+namespace Solver2x2{
+
+    //batch solve, a cube at time
+    void TableBackend::solve(const uint32_t idx[], uint64_t res[], uint32_t n){
+        uint32_t i;
+
+        for(i = 0; i < n; i++)
+            res[i] = solve((uint16_t)(idx[i] / PERM_CASES), (uint16_t)(idx[i] % PERM_CASES));
+    }
+
+    //batch depth, a cube at time
+    void TableBackend::depth(const uint32_t idx[], int8_t res[], uint32_t n){
+        uint32_t i;
+
+        for(i = 0; i < n; i++)
+            res[i] = Explore::Scramble::depth(solve((uint16_t)(idx[i] / PERM_CASES), (uint16_t)(idx[i] % PERM_CASES)));
+    }
+
+    //use the scrambles
+    FullBackend::FullBackend(Explore::Scramble* scramble) : scramble(scramble){}
+
+    //solve
+    uint64_t FullBackend::solve(uint16_t ori, uint16_t perm){
+        return scramble->solve(ori, perm);
+    }
+
+    //batch solve with prefetch
+    void FullBackend::solve(const uint32_t idx[], uint64_t res[], uint32_t n){
+        scramble->solve(idx, res, n);
+    }
+
+    //batch depth with gather
+    void FullBackend::depth(const uint32_t idx[], int8_t res[], uint32_t n){
+        scramble->depth(idx, res, n);
+    }
+
+    //write
+    bool FullBackend::write(const std::string& name) const{
+        return scramble->write(name);
+    }
+
+    //read
+    bool FullBackend::read(const std::string& name){
+        return scramble->read(name);
+    }
+
+    //memory
+    size_t FullBackend::bytes() const{
+        return sizeof(uint64_t) * CUBE_CASES;
+    }
+
+    //allocate the packed table
+    PackedBackend::PackedBackend(Coords& coords, int8_t bits) :
+            coords(coords), bits(bits), size(((size_t)CUBE_CASES * bits + 7) / 8){
+        table = new uint8_t[size]();
+    }
+
+    //deallocate the packed table
+    PackedBackend::~PackedBackend(){
+        delete[] table;
+    }
+
+    //get a value
+    uint8_t PackedBackend::get(uint32_t idx) const{
+        uint32_t bit = idx * bits;
+
+        return (uint8_t)((table[bit >> 3] >> (bit & 7)) & ((1 << bits) - 1));
+    }
+
+    //set a value
+    void PackedBackend::set(uint32_t idx, uint8_t value){
+        uint32_t bit = idx * bits;
+
+        table[bit >> 3] = (uint8_t)((table[bit >> 3] & ~(((1 << bits) - 1) << (bit & 7))) | (value << (bit & 7)));
+    }
+
+    //find the moves
+    uint64_t PackedBackend::descend(uint16_t ori, uint16_t perm, int8_t depth){
+        uint64_t res = 0;
+        uint16_t newOri = 0, newPerm = 0;
+        uint8_t value, want;
+        int8_t n = 0, m;
+
+        value = get(Explore::Scramble::index(ori, perm));
+
+        //the first move of the solution is in the lowest bits after the size
+        while((depth < 0 ? (ori != 0 || perm != 0) : n < depth) && n < MAX_DEPTH - 1){
+            want = previous(value);
+
+            for(m = 0; m < N_MOVES; m++){
+                newOri = coords.moveCOri(ori, m);
+                newPerm = coords.moveCPerm(perm, m);
+
+                if(get(Explore::Scramble::index(newOri, newPerm)) == want)
+                    break;
+            }
+
+            if(m == N_MOVES)
+                break;
+
+            res |= (uint64_t)m << (4 * (n + 1));
+            n++;
+
+            ori = newOri;
+            perm = newPerm;
+            value = want;
+        }
+
+        return res | (uint64_t)n;
+    }
+
+    //write
+    bool PackedBackend::write(const std::string& name) const{
+        std::ofstream file(name, std::ios::binary);
+
+        if(!file)
+            return false;
+
+        file.write(reinterpret_cast<const char *>(table), (std::streamsize)size);
+
+        return (bool)file;
+    }
+
+    //read
+    bool PackedBackend::read(const std::string& name){
+        std::ifstream file(name, std::ios::binary | std::ios::ate);
+
+        if(!file || (size_t)file.tellg() != size)
+            return false;
+
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(table), (std::streamsize)size);
+
+        return (bool)file;
+    }
+
+    //memory
+    size_t PackedBackend::bytes() const{
+        return size;
+    }
+
+    //store the depths
+    DepthBackend::DepthBackend(Coords& coords, const Explore::Scramble* scramble) : PackedBackend(coords, 4){
+        uint32_t i;
+
+        if(scramble == nullptr)
+            return;
+
+        for(i = 0; i < CUBE_CASES; i++)
+            set(i, (uint8_t)Explore::Scramble::depth(scramble->scrambleArray[i]));
+    }
+
+    //previous depth
+    uint8_t DepthBackend::previous(uint8_t value) const{
+        return (uint8_t)(value - 1);
+    }
+
+    //solve
+    uint64_t DepthBackend::solve(uint16_t ori, uint16_t perm){
+        return descend(ori, perm, (int8_t)get(Explore::Scramble::index(ori, perm)));
+    }
+
+    //batch depth, a read for every cube
+    void DepthBackend::depth(const uint32_t idx[], int8_t res[], uint32_t n){
+        uint32_t i;
+
+        for(i = 0; i < n; i++)
+            res[i] = (int8_t)get(idx[i]);
+    }
+
+    //store the depths modulo 3
+    Mod3Backend::Mod3Backend(Coords& coords, const Explore::Scramble* scramble) : PackedBackend(coords, 2){
+        uint32_t i;
+
+        if(scramble == nullptr)
+            return;
+
+        for(i = 0; i < CUBE_CASES; i++)
+            set(i, (uint8_t)(Explore::Scramble::depth(scramble->scrambleArray[i]) % 3));
+    }
+
+    //previous depth modulo 3
+    uint8_t Mod3Backend::previous(uint8_t value) const{
+        return (uint8_t)((value + 2) % 3);
+    }
+
+    //solve, the depth is the number of moves to the solved cube
+    uint64_t Mod3Backend::solve(uint16_t ori, uint16_t perm){
+        return descend(ori, perm, -1);
+    }
+
+    //visit the cubes near the solved one
+    MeetBackend::MeetBackend(Coords& coords) : coords(coords), table((size_t)1 << MEET_BITS, MEET_EMPTY){
+        std::vector<uint32_t> frontier, next;
+        uint16_t ori, perm;
+        int8_t d, m;
+
+        add(0, 0, 0);
+        frontier.push_back(0);
+
+        //the move back is the first move to solve the cube
+        for(d = 1; d <= MEET_DEPTH; d++){
+            next.clear();
+
+            for(uint32_t idx : frontier)
+                for(m = 0; m < N_MOVES; m++){
+                    ori = coords.moveCOri((uint16_t)(idx / PERM_CASES), m);
+                    perm = coords.moveCPerm((uint16_t)(idx % PERM_CASES), m);
+
+                    if(add(Explore::Scramble::index(ori, perm), d, invMove(m)))
+                        next.push_back(Explore::Scramble::index(ori, perm));
+                }
+
+            frontier.swap(next);
+        }
+    }
+
+    //find a cube, linear probing
+    uint32_t MeetBackend::find(uint32_t idx) const{
+        uint32_t mask = (uint32_t)table.size() - 1;
+        uint32_t h = (idx * 2654435761u) >> (32 - MEET_BITS);
+
+        while(table[h] != MEET_EMPTY && table[h] >> 8 != idx)
+            h = (h + 1) & mask;
+
+        return table[h];
+    }
+
+    //add a cube, linear probing
+    bool MeetBackend::add(uint32_t idx, int8_t depth, int8_t move){
+        uint32_t mask = (uint32_t)table.size() - 1;
+        uint32_t h = (idx * 2654435761u) >> (32 - MEET_BITS);
+
+        while(table[h] != MEET_EMPTY){
+            if(table[h] >> 8 == idx)
+                return false;
+
+            h = (h + 1) & mask;
+        }
+
+        table[h] = idx << 8 | (uint32_t)depth << 4 | (uint32_t)move;
+
+        return true;
+    }
+
+    //follow the first moves of the hash
+    uint64_t MeetBackend::finish(uint32_t entry, uint64_t res, int8_t n) const{
+        uint16_t ori, perm;
+        int8_t move;
+
+        while(((entry >> 4) & 0xF) != 0){
+            move = (int8_t)(entry & 0xF);
+            res |= (uint64_t)move << (4 * (n + 1));
+            n++;
+
+            ori = coords.moveCOri((uint16_t)((entry >> 8) / PERM_CASES), move);
+            perm = coords.moveCPerm((uint16_t)((entry >> 8) % PERM_CASES), move);
+            entry = find(Explore::Scramble::index(ori, perm));
+        }
+
+        return res | (uint64_t)n;
+    }
+
+    //search the moves to the hash
+    uint64_t MeetBackend::search(uint16_t ori, uint16_t perm, int8_t left, int8_t axis, uint64_t res, int8_t n){
+        uint64_t found;
+        uint32_t entry;
+        int8_t m;
+
+        if(left == 0){
+            entry = find(Explore::Scramble::index(ori, perm));
+
+            return entry == MEET_EMPTY ? 0 : finish(entry, res, n);
+        }
+
+        //two moves of the same axis are a single move
+        for(m = 0; m < N_MOVES; m++){
+            if(m / 3 == axis)
+                continue;
+
+            found = search(coords.moveCOri(ori, m), coords.moveCPerm(perm, m), (int8_t)(left - 1), (int8_t)(m / 3),
+                           res | (uint64_t)m << (4 * (n + 1)), (int8_t)(n + 1));
+
+            if(found != 0)
+                return found;
+        }
+
+        return 0;
+    }
+
+    //solve, the shortest search that reaches the hash
+    uint64_t MeetBackend::solve(uint16_t ori, uint16_t perm){
+        uint64_t found;
+        uint32_t entry;
+        int8_t left;
+
+        entry = find(Explore::Scramble::index(ori, perm));
+
+        if(entry != MEET_EMPTY)
+            return finish(entry, 0, 0);
+
+        for(left = 1; left < MAX_DEPTH - MEET_DEPTH; left++){
+            found = search(ori, perm, left, -1, 0, 0);
+
+            if(found != 0)
+                return found;
+        }
+
+        return 0;
+    }
+
+    //write
+    bool MeetBackend::write(const std::string& name) const{
+        std::ofstream file(name, std::ios::binary);
+
+        if(!file)
+            return false;
+
+        file.write(reinterpret_cast<const char *>(table.data()), (std::streamsize)(sizeof(uint32_t) * table.size()));
+
+        return (bool)file;
+    }
+
+    //read
+    bool MeetBackend::read(const std::string& name){
+        std::ifstream file(name, std::ios::binary | std::ios::ate);
+
+        if(!file || (size_t)file.tellg() != sizeof(uint32_t) * table.size())
+            return false;
+
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(table.data()), (std::streamsize)(sizeof(uint32_t) * table.size()));
+
+        return (bool)file;
+    }
+
+    //memory
+    size_t MeetBackend::bytes() const{
+        return sizeof(uint32_t) * table.size();
+    }
+
+    //the first bytes of the block file
+    static const char BLOCK_MAGIC[4] = {'S', '2', 'Z', '1'};
+
+    //the header: the magic, the blocks, the cubes of a block and the bytes of the numbers
+    #define BLOCK_HEADER 16
+
+    //the first number of every depth, the scrambles of a depth d are 9×6^(d-1)
+    static const uint32_t CODE_START[MAX_DEPTH + 1] = {
+        0, 1, 10, 64, 388, 2332, 13996, 83980, 503884, 3023308, 18139852, 108839116, 653034700
+    };
+
+    //the ids of the tables
+    static std::atomic<uint64_t> nextBlockId{1};
+
+    //the last blocks read by a thread, a cube is decompressed at its first read
+    struct BlockCache{
+        uint64_t owner[BLOCK_CACHE]{};
+        uint32_t block[BLOCK_CACHE]{};
+        uint64_t ready[BLOCK_CACHE][(BLOCK_CASES + 63) / 64]{};
+        uint64_t cubes[BLOCK_CACHE][BLOCK_CASES];
+    };
+
+    static thread_local BlockCache blockCache;
+
+    //the bytes of the numbers of a block
+    static uint32_t blockBytes(uint8_t width){
+        return (BLOCK_CASES * width + 7) / 8;
+    }
+
+    //the bytes of the header, the offsets and the bits
+    static size_t blockIndexBytes(){
+        return BLOCK_HEADER + sizeof(uint32_t) * (BLOCKS + 1) + (BLOCKS + 3) / 4 * 4;
+    }
+
+    //the depth of a number
+    static int8_t codeDepth(uint32_t code){
+        int8_t d = 0;
+
+        while(d + 1 < MAX_DEPTH && code >= CODE_START[d + 1])
+            d++;
+
+        return d;
+    }
+
+    //compress the scrambles, the numbers are read 8 bytes at time so there are 8 more
+    BlockBackend::BlockBackend(const Explore::Scramble* scramble) : id(nextBlockId.fetch_add(1)){
+        std::vector<uint32_t> numbers(BLOCK_CASES);
+        std::vector<uint8_t> bits(BLOCKS);
+        std::vector<uint32_t> starts(BLOCKS + 1);
+        uint32_t b, i, max, bit;
+        uint64_t word;
+        uint8_t* dst;
+
+        if(scramble == nullptr)
+            return;
+
+        starts[0] = 0;
+
+        for(b = 0; b < BLOCKS; b++){
+            max = 1;
+
+            for(i = 0; i < BLOCK_CASES; i++)
+                max = std::max(max, encode(scramble->scrambleArray[b * BLOCK_CASES + i]));
+
+            for(bits[b] = 0; (max >> bits[b]) != 0; bits[b]++);
+
+            starts[b + 1] = starts[b] + blockBytes(bits[b]);
+        }
+
+        built.assign(blockIndexBytes() + starts[BLOCKS] + sizeof(uint64_t), 0);
+
+        memcpy(built.data(), BLOCK_MAGIC, sizeof(BLOCK_MAGIC));
+        reinterpret_cast<uint32_t*>(built.data())[1] = BLOCKS;
+        reinterpret_cast<uint32_t*>(built.data())[2] = BLOCK_CASES;
+        reinterpret_cast<uint32_t*>(built.data())[3] = starts[BLOCKS];
+        memcpy(built.data() + BLOCK_HEADER, starts.data(), sizeof(uint32_t) * (BLOCKS + 1));
+        memcpy(built.data() + BLOCK_HEADER + sizeof(uint32_t) * (BLOCKS + 1), bits.data(), BLOCKS);
+
+        dst = built.data() + blockIndexBytes();
+
+        for(b = 0; b < BLOCKS; b++){
+            for(i = 0; i < BLOCK_CASES; i++){
+                bit = i * bits[b];
+                memcpy(&word, &dst[starts[b] + bit / 8], sizeof(word));
+                word |= (uint64_t)encode(scramble->scrambleArray[b * BLOCK_CASES + i]) << (bit % 8);
+                memcpy(&dst[starts[b] + bit / 8], &word, sizeof(word));
+            }
+        }
+
+        attach(built.data(), built.size());
+    }
+
+    //the parts of the table, checked
+    bool BlockBackend::attach(const uint8_t* bytes, size_t length){
+        const auto* header = reinterpret_cast<const uint32_t*>(bytes);
+        uint32_t b;
+
+        table = nullptr;
+        size = 0;
+
+        if(length < blockIndexBytes() || memcmp(bytes, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0 ||
+           header[1] != BLOCKS || header[2] != BLOCK_CASES || length != blockIndexBytes() + header[3] + sizeof(uint64_t))
+            return false;
+
+        offsets = reinterpret_cast<const uint32_t*>(bytes + BLOCK_HEADER);
+        widths = bytes + BLOCK_HEADER + sizeof(uint32_t) * (BLOCKS + 1);
+        codes = bytes + blockIndexBytes();
+
+        for(b = 0; b < BLOCKS; b++)
+            if(widths[b] > 32 || offsets[b + 1] - offsets[b] != blockBytes(widths[b]))
+                return false;
+
+        if(offsets[0] != 0 || offsets[BLOCKS] != header[3])
+            return false;
+
+        table = bytes;
+        size = length;
+
+        return true;
+    }
+
+    //scramble to number, the moves after the first say the face and the turns
+    uint32_t BlockBackend::encode(uint64_t scramble){
+        int8_t d = Explore::Scramble::depth(scramble), k;
+        uint32_t value;
+        uint8_t move, prev;
+
+        if(d == 0)
+            return 0;
+
+        prev = (uint8_t)((scramble >> 4) & 0xF);
+        value = prev;
+
+        for(k = 1; k < d; k++){
+            move = (uint8_t)((scramble >> (4 * (k + 1))) & 0xF);
+            value = value * 6 + ((move / 3 - prev / 3 + 2) % 3) * 3 + move % 3;
+            prev = move;
+        }
+
+        return CODE_START[d] + value;
+    }
+
+    //three moves after a face: the 12 bits of the moves and the last face << 12
+    struct TripleMoves{
+        uint16_t moves[3][216];
+
+        TripleMoves(){
+            const uint32_t weights[3] = {36, 6, 1};
+            uint8_t face, f, move, digit, k;
+            uint32_t t;
+
+            for(face = 0; face < 3; face++){
+                for(t = 0; t < 216; t++){
+                    moves[face][t] = 0;
+                    f = face;
+
+                    for(k = 0; k < 3; k++){
+                        digit = (uint8_t)(t / weights[k] % 6);
+                        f = (uint8_t)((f + 1 + digit / 3) % 3);
+                        move = (uint8_t)(f * 3 + digit % 3);
+                        moves[face][t] |= (uint16_t)(move << (4 * k));
+                    }
+
+                    moves[face][t] |= (uint16_t)(f << 12);
+                }
+            }
+        }
+    };
+
+    static const TripleMoves tripleMoves;
+
+    //number to scramble, the last moves three at time
+    uint64_t BlockBackend::decode(uint32_t code){
+        int8_t d = codeDepth(code), k, triples, lead;
+        uint8_t chunks[MAX_DEPTH / 3 + 1];
+        uint64_t res = (uint64_t)d;
+        uint32_t value = code - CODE_START[d];
+        uint8_t face, move, digit;
+        uint16_t moves;
+
+        if(d == 0)
+            return 0;
+
+        triples = (int8_t)((d - 1) / 3);
+        lead = (int8_t)((d - 1) % 3);
+
+        for(k = (int8_t)(triples - 1); k >= 0; k--){
+            chunks[k] = (uint8_t)(value % 216);
+            value /= 216;
+        }
+
+        //the moves before the triples, the first one is the biggest digit
+        digit = lead == 2 ? (uint8_t)(value % 36 / 6) : (uint8_t)(value % 6);
+        move = (uint8_t)(value / (lead == 2 ? 36 : lead == 1 ? 6 : 1));
+        res |= (uint64_t)move << 4;
+
+        for(k = 1; k <= lead; k++){
+            face = (uint8_t)((move / 3 + 1 + digit / 3) % 3);
+            move = (uint8_t)(face * 3 + digit % 3);
+            res |= (uint64_t)move << (4 * (k + 1));
+            digit = (uint8_t)(value % 6);
+        }
+
+        face = (uint8_t)(move / 3);
+
+        for(k = 0; k < triples; k++){
+            moves = tripleMoves.moves[face][chunks[k]];
+            res |= (uint64_t)(moves & 0xFFF) << (4 * (lead + 2 + 3 * k));
+            face = (uint8_t)(moves >> 12);
+        }
+
+        return res;
+    }
+
+    //number of a cube, without decompressing the block
+    uint32_t BlockBackend::code(uint32_t idx) const{
+        uint32_t b = idx / BLOCK_CASES, bit = (idx % BLOCK_CASES) * widths[b];
+        uint64_t word;
+
+        memcpy(&word, &codes[offsets[b] + bit / 8], sizeof(word));
+
+        return (uint32_t)((word >> (bit % 8)) & ((1ull << widths[b]) - 1));
+    }
+
+    //cube from the cache of the thread, the block replaces the one in its slot
+    uint64_t BlockBackend::decompress(uint32_t idx) const{
+        uint32_t block = idx / BLOCK_CASES, slot = block % BLOCK_CACHE, i = idx % BLOCK_CASES;
+        uint64_t* ready = blockCache.ready[slot];
+
+        if(blockCache.owner[slot] != id || blockCache.block[slot] != block){
+            blockCache.owner[slot] = id;
+            blockCache.block[slot] = block;
+            memset(ready, 0, sizeof(blockCache.ready[slot]));
+        }
+
+        if((ready[i / 64] >> (i % 64) & 1) == 0){
+            blockCache.cubes[slot][i] = decode(code(idx));
+            ready[i / 64] |= 1ull << (i % 64);
+        }
+
+        return blockCache.cubes[slot][i];
+    }
+
+    //solve from the cache
+    uint64_t BlockBackend::solve(uint16_t ori, uint16_t perm){
+        return decompress(Explore::Scramble::index(ori, perm));
+    }
+
+    //batch depth, the depth is given by the number
+    void BlockBackend::depth(const uint32_t idx[], int8_t res[], uint32_t n){
+        uint32_t i;
+
+        for(i = 0; i < n; i++)
+            res[i] = codeDepth(code(idx[i]));
+    }
+
+    //write the table as it is, the file can be the mapped one
+    bool BlockBackend::write(const std::string& name) const{
+        std::ofstream file;
+
+        if(table == nullptr)
+            return false;
+
+        //a truncated mapping would fault the solves
+        file.open(MappedFile::temporary(name), std::ios::binary);
+
+        if(!file)
+            return false;
+
+        file.write(reinterpret_cast<const char *>(table), (std::streamsize)size);
+        file.close();
+
+        return MappedFile::replace(name, !file.fail());
+    }
+
+    //map the table
+    bool BlockBackend::read(const std::string& name){
+        built = std::vector<uint8_t>();
+
+        if(!mapped.open(name) || !attach(mapped.bytes(), mapped.size())){
+            mapped.close();
+            return false;
+        }
+
+        return true;
+    }
+
+    //memory, the pages of the file are shared
+    size_t BlockBackend::bytes() const{
+        return size;
+    }
+}
@@ -0,0 +1,444 @@
+/**
+ * This file contains the tables used to solve the cubes.
+ * Every table gives the same compressed scrambles of
+ * Explore::Scramble, with a different memory and time:
+ *
+ * FullBackend  : the scrambles, 29 MB, a read for every cube.
+ * DepthBackend : the depths in 4 bits, 1.8 MB, the moves are found
+ *                with the depths of the next cubes.
+ * Mod3Backend  : the depths modulo 3 in 2 bits, 0.9 MB, the moves are
+ *                found like DepthBackend, the depth counting them.
+ * MeetBackend  : the cubes near the solved one, 0.5 MB, the moves are
+ *                searched until one of them is found.
+ * BlockBackend : the scrambles compressed in blocks, 12 MB, a cube reads
+ *                only its block, the last blocks are kept by the threads.
+ */
+
+#ifndef SOLVER2X2_CXX_BACKEND_H
+#define SOLVER2X2_CXX_BACKEND_H
+
+#include <vector>
+#include "Explore.h"
+#include "MappedFile.h"
+
+/**
+ * The depth of the cubes stored by MeetBackend.
+ */
+#define MEET_DEPTH 6
+
+/**
+ * The bits of the hash of MeetBackend, 2^17 entries for the
+ * 62360 cubes within MEET_DEPTH moves.
+ */
+#define MEET_BITS 17
+
+/**
+ * The empty entry of the hash.
+ */
+#define MEET_EMPTY UINT32_MAX
+
+/**
+ * The cubes of a block of BlockBackend, 60 blocks for every orientation.
+ */
+#define BLOCK_CASES 84
+
+/**
+ * The blocks of BlockBackend.
+ */
+#define BLOCKS (CUBE_CASES / BLOCK_CASES)
+
+/**
+ * The blocks kept decompressed by every thread.
+ */
+#define BLOCK_CACHE 16
+
+namespace Solver2x2{
+
+    /**
+     * Class TableBackend
+     * The interface of the tables.
+     */
+    class TableBackend{
+    public:
+
+        /**
+         * Deallocate the table.
+         */
+        virtual ~TableBackend() = default;
+
+        /**
+         * Return the solve moves.
+         *
+         * @param ori       : Corner orientation.
+         * @param perm      : Corner permutation.
+         * @return          : The compressed scramble.
+         */
+        virtual uint64_t solve(uint16_t ori, uint16_t perm) = 0;
+
+        /**
+         * Return the solve moves of a batch of cubes.
+         *
+         * @param idx       : The indexes of the cubes.
+         * @param res       : The array to store the compressed scrambles.
+         * @param n         : The number of cubes.
+         */
+        virtual void solve(const uint32_t idx[], uint64_t res[], uint32_t n);
+
+        /**
+         * Return the number of moves to solve a batch of cubes.
+         *
+         * @param idx       : The indexes of the cubes.
+         * @param res       : The array to store the depths.
+         * @param n         : The number of cubes.
+         */
+        virtual void depth(const uint32_t idx[], int8_t res[], uint32_t n);
+
+        /**
+         * Write the table into a file.
+         *
+         * @param name      : The name of the file.
+         * @return          : True if the file is written.
+         */
+        virtual bool write(const std::string& name) const = 0;
+
+        /**
+         * Read the table from a file.
+         *
+         * @param name      : The name of the file.
+         * @return          : True if the file is read.
+         */
+        virtual bool read(const std::string& name) = 0;
+
+        /**
+         * Get the memory of the table.
+         *
+         * @return          : The bytes used.
+         */
+        virtual size_t bytes() const = 0;
+    };
+
+    /**
+     * Class FullBackend
+     * The scrambles of all the cubes, it does not own them.
+     */
+    class FullBackend : public TableBackend{
+    private:
+
+        ///the scrambles
+        Explore::Scramble* scramble;
+
+    public:
+
+        /**
+         * Use the scrambles.
+         *
+         * @param scramble  : The scrambles, they are not deallocated.
+         */
+        explicit FullBackend(Explore::Scramble* scramble);
+
+        uint64_t solve(uint16_t ori, uint16_t perm) override;
+        void solve(const uint32_t idx[], uint64_t res[], uint32_t n) override;
+        void depth(const uint32_t idx[], int8_t res[], uint32_t n) override;
+        bool write(const std::string& name) const override;
+        bool read(const std::string& name) override;
+        size_t bytes() const override;
+    };
+
+    /**
+     * Class PackedBackend
+     * A value of few bits for every cube, the moves are found
+     * looking the values of the cubes after every move.
+     */
+    class PackedBackend : public TableBackend{
+    protected:
+
+        ///the coords to move the cubes
+        Coords& coords;
+
+        ///the values, (8/bits) for every byte
+        uint8_t* table;
+
+        ///the bits of a value
+        const int8_t bits;
+
+        ///the bytes of the table
+        const size_t size;
+
+        /**
+         * Allocate the table.
+         *
+         * @param coords    : The coords to move the cubes.
+         * @param bits      : The bits of a value, 2 or 4.
+         */
+        PackedBackend(Coords& coords, int8_t bits);
+
+        /**
+         * Get a value.
+         *
+         * @param idx       : The index of the cube.
+         * @return          : The value.
+         */
+        uint8_t get(uint32_t idx) const;
+
+        /**
+         * Set a value.
+         *
+         * @param idx       : The index of the cube.
+         * @param value     : The value.
+         */
+        void set(uint32_t idx, uint8_t value);
+
+        /**
+         * Find the moves to the solved cube, every move goes to the cube
+         * with the value of the previous depth.
+         *
+         * @param ori       : Corner orientation.
+         * @param perm      : Corner permutation.
+         * @param depth     : The number of moves, -1 to stop at the solved cube.
+         * @return          : The compressed scramble.
+         */
+        uint64_t descend(uint16_t ori, uint16_t perm, int8_t depth);
+
+        /**
+         * Get the value of the previous depth.
+         *
+         * @param value     : The value of a cube.
+         * @return          : The value of the cube one move nearer.
+         */
+        virtual uint8_t previous(uint8_t value) const = 0;
+
+    public:
+
+        /**
+         * Deallocate the table.
+         */
+        ~PackedBackend() override;
+
+        bool write(const std::string& name) const override;
+        bool read(const std::string& name) override;
+        size_t bytes() const override;
+    };
+
+    /**
+     * Class DepthBackend
+     * The depths of all the cubes, 4 bits each.
+     */
+    class DepthBackend : public PackedBackend{
+    protected:
+        uint8_t previous(uint8_t value) const override;
+
+    public:
+
+        /**
+         * Store the depths of the scrambles, nullptr for an empty table to read.
+         *
+         * @param coords    : The coords to move the cubes.
+         * @param scramble  : The scrambles.
+         */
+        DepthBackend(Coords& coords, const Explore::Scramble* scramble);
+
+        uint64_t solve(uint16_t ori, uint16_t perm) override;
+        void depth(const uint32_t idx[], int8_t res[], uint32_t n) override;
+    };
+
+    /**
+     * Class Mod3Backend
+     * The depths modulo 3 of all the cubes, 2 bits each. After
+     * a move the depth changes at most by one, so the modulo
+     * is enough to know which move goes nearer.
+     */
+    class Mod3Backend : public PackedBackend{
+    protected:
+        uint8_t previous(uint8_t value) const override;
+
+    public:
+
+        /**
+         * Store the depths modulo 3 of the scrambles, nullptr for an empty table to read.
+         *
+         * @param coords    : The coords to move the cubes.
+         * @param scramble  : The scrambles.
+         */
+        Mod3Backend(Coords& coords, const Explore::Scramble* scramble);
+
+        uint64_t solve(uint16_t ori, uint16_t perm) override;
+    };
+
+    /**
+     * Class MeetBackend
+     * The cubes within MEET_DEPTH moves of the solved one, in a hash,
+     * with the first move to solve them. The other cubes are solved
+     * searching all the sequences of 1, 2, ... moves, until one of them
+     * gives a cube of the hash. Every cube has at most MAX_DEPTH - 1 moves,
+     * so MAX_DEPTH - 1 - MEET_DEPTH moves are searched at most.
+     *
+     * The solutions are optimal: the first sequence that finds a cube
+     * of the hash has the number of moves of the cube minus MEET_DEPTH.
+     */
+    class MeetBackend : public TableBackend{
+    private:
+
+        ///the coords to move the cubes
+        Coords& coords;
+
+        ///index of the cube << 8 | depth << 4 | first move, MEET_EMPTY for the empty ones
+        std::vector<uint32_t> table;
+
+        /**
+         * Find a cube in the hash.
+         *
+         * @param idx       : The index of the cube.
+         * @return          : The entry, MEET_EMPTY if it is not there.
+         */
+        uint32_t find(uint32_t idx) const;
+
+        /**
+         * Add a cube to the hash, if it is not there.
+         *
+         * @param idx       : The index of the cube.
+         * @param depth     : The number of moves to solve it.
+         * @param move      : The first move to solve it.
+         * @return          : True if it is added.
+         */
+        bool add(uint32_t idx, int8_t depth, int8_t move);
+
+        /**
+         * Add the moves of a cube of the hash to a solution.
+         *
+         * @param entry     : The entry of the cube.
+         * @param res       : The moves found before the cube.
+         * @param n         : The number of moves found before the cube.
+         * @return          : The compressed scramble.
+         */
+        uint64_t finish(uint32_t entry, uint64_t res, int8_t n) const;
+
+        /**
+         * Search all the sequences of moves until a cube of the hash.
+         *
+         * @param ori       : Corner orientation.
+         * @param perm      : Corner permutation.
+         * @param left      : The moves to do.
+         * @param axis      : The axis of the last move, it is not moved again.
+         * @param res       : The moves done.
+         * @param n         : The number of moves done.
+         * @return          : The compressed scramble, 0 if not found.
+         */
+        uint64_t search(uint16_t ori, uint16_t perm, int8_t left, int8_t axis, uint64_t res, int8_t n);
+
+    public:
+
+        /**
+         * Store the cubes near the solved one, with a visit from it.
+         * The scrambles are not needed.
+         *
+         * @param coords    : The coords to move the cubes.
+         */
+        explicit MeetBackend(Coords& coords);
+
+        uint64_t solve(uint16_t ori, uint16_t perm) override;
+        bool write(const std::string& name) const override;
+        bool read(const std::string& name) override;
+        size_t bytes() const override;
+    };
+
+    /**
+     * Class BlockBackend
+     * The scrambles of BLOCK_CASES cubes are compressed together, so a
+     * cube reads only its block and the file can be mapped as it is.
+     *
+     * A scramble is a single number: the scrambles with less moves
+     * come first, then the first move is one of 9 and every other move
+     * one of 6, because an optimal solution never turns the same face
+     * twice in a row. The numbers of a block use the bits of its
+     * biggest number, so a depth of 10 is 27 bits instead of 64.
+     *
+     * The table is the same in memory and in the file: a header, the
+     * offset of every block, the bits of every block and the numbers.
+     */
+    class BlockBackend : public TableBackend{
+    private:
+
+        ///the table, built or mapped
+        const uint8_t* table = nullptr;
+
+        ///the bytes of the table
+        size_t size = 0;
+
+        ///the offset of every block from the numbers, and the end
+        const uint32_t* offsets = nullptr;
+
+        ///the bits of a number of every block
+        const uint8_t* widths = nullptr;
+
+        ///the numbers
+        const uint8_t* codes = nullptr;
+
+        ///the built table
+        std::vector<uint8_t> built;
+
+        ///the read table
+        MappedFile mapped;
+
+        ///the table in the caches of the threads, never reused
+        const uint64_t id;
+
+        /**
+         * Find the parts of the table.
+         *
+         * @param bytes     : The table.
+         * @param length    : The bytes of the table.
+         * @return          : True if the table is correct.
+         */
+        bool attach(const uint8_t* bytes, size_t length);
+
+        /**
+         * Get the number of a cube.
+         *
+         * @param idx       : The index of the cube.
+         * @return          : The number.
+         */
+        uint32_t code(uint32_t idx) const;
+
+        /**
+         * Get the scramble of a cube from the cache of the thread, it is
+         * decompressed at the first read of the block.
+         *
+         * @param idx       : The index of the cube.
+         * @return          : The compressed scramble.
+         */
+        uint64_t decompress(uint32_t idx) const;
+
+    public:
+
+        /**
+         * Compress the scrambles, nullptr for an empty table to read.
+         *
+         * @param scramble  : The scrambles, they must be optimal.
+         */
+        explicit BlockBackend(const Explore::Scramble* scramble);
+
+        /**
+         * Convert a scramble into its number.
+         *
+         * @param scramble  : The compressed scramble.
+         * @return          : The number.
+         */
+        static uint32_t encode(uint64_t scramble);
+
+        /**
+         * Convert a number into its scramble.
+         *
+         * @param code      : The number.
+         * @return          : The compressed scramble.
+         */
+        static uint64_t decode(uint32_t code);
+
+        uint64_t solve(uint16_t ori, uint16_t perm) override;
+        void depth(const uint32_t idx[], int8_t res[], uint32_t n) override;
+        bool write(const std::string& name) const override;
+        bool read(const std::string& name) override;
+        size_t bytes() const override;
+    };
+}
+
+#endif //SOLVER2X2_CXX_BACKEND_H
@@ -5,6 +5,7 @@
 #include <cstring>
 #include <cassert>
 #include "Coords.h"
+#include "Simd.h"
 
 namespace Solver2x2 {
 
@@ -27,6 +28,7 @@ namespace Solver2x2 {
                 memcpy(cube2, cube, N_CORNERS);
                 moveOri(cube2, j);
                 cOri[i][j] = comCOri(cube2);
+                tOri[j][i] = cOri[i][j];
             }
         }
     }
@@ -89,6 +91,7 @@ namespace Solver2x2 {
                 memcpy(cube2, cube, N_CORNERS);
                 movePerm(cube2, j);
                 cPerm[i][j] = compCPerm(cube2);
+                tPerm[j][i] = cPerm[i][j];
             }
         }
     }
@@ -151,12 +154,207 @@ namespace Solver2x2 {
 
         c[DBR] = c[DBL];
         c[DBL] = DBL;
+
+        //the coordinate counts the DBR corner in place of DBL
+        for (i = UFR; i <= DBR; i++)
+            if (i != DBL && c[i] == DBL)
+                c[i] = DBR;
+    }
+
+    //all the corners
+
+    uint16_t Coords::comFullOri(const int8_t c[]) {
+        int8_t i;
+        uint16_t ori = 0;
+
+        for (i = UFR; i < DBR; i++)
+            ori = ori*C_STATES+c[i];
+
+        return ori;
+    }
+
+    void Coords::invFullOri(int8_t c[], uint16_t coord) {
+        int8_t i, parity;
+
+        parity = 0;
+
+        for (i = DBR - 1; i >= UFR; i--) {
+            parity += coord%C_STATES;
+            c[i] = (int8_t)(coord % C_STATES);
+            coord /= C_STATES;
+        }
+
+        //the twist of the last corner makes the sum a multiple of 3
+        c[DBR] = (int8_t)((C_STATES - parity%C_STATES) % C_STATES);
+    }
+
+    uint16_t Coords::compFullPerm(const int8_t c[]) {
+        int8_t i, j, count;
+        uint16_t perm = 0;
+
+        for (i = DBR; i > UFR; i--) {
+            count = 0;
+
+            for (j = (int8_t)(i-1); j >= 0; j--)
+                if (c[j] > c[i])
+                    count++;
+
+            perm = (perm+count)*i;
+        }
+
+        return perm;
+    }
+
+    void Coords::invFullPerm(int8_t c[], uint16_t coord) {
+        bool explored[N_CORNERS];
+        int8_t order[N_CORNERS];
+        int8_t i, count;
+
+        for (i = UFR; i <= DBR; i++) {
+            explored[i] = false;
+            order[i] = (int8_t)(coord%(i+1));
+            coord /= (i+1);
+        }
+
+        for (i = DBR; i >= UFR; i--) {
+            count = DBR;
+
+            while (explored[count])
+                count--;
+
+            while (order[i] > 0) {
+                order[i]--;
+
+                do{
+                    count--;
+                }while (explored[count]);
+            }
+
+            c[i] = (int8_t)count;
+            explored[count] = true;
+        }
+    }
+
+    void Coords::compose(uint16_t oriA, uint16_t permA, uint16_t oriB, uint16_t permB, uint16_t& ori, uint16_t& perm) {
+        int8_t oA[N_CORNERS], pA[N_CORNERS], oB[N_CORNERS], pB[N_CORNERS];
+        int8_t o[N_CORNERS], p[N_CORNERS];
+        int8_t i;
+
+        invCOri(oA, oriA);
+        invCPerm(pA, permA);
+        invCOri(oB, oriB);
+        invCPerm(pB, permB);
+
+        for (i = UFR; i <= DBR; i++) {
+            p[i] = pA[pB[i]];
+            o[i] = (int8_t)((oA[pB[i]] + oB[i]) % C_STATES);
+        }
+
+        ori = comCOri(o);
+        perm = compCPerm(p);
+    }
+
+    void Coords::inverse(uint16_t ori, uint16_t perm, uint16_t& invOri, uint16_t& invPerm) {
+        int8_t o[N_CORNERS], p[N_CORNERS], iO[N_CORNERS], iP[N_CORNERS];
+        int8_t i;
+
+        invCOri(o, ori);
+        invCPerm(p, perm);
+
+        for (i = UFR; i <= DBR; i++) {
+            iP[p[i]] = i;
+            iO[p[i]] = (int8_t)((C_STATES - o[i]) % C_STATES);
+        }
+
+        invOri = comCOri(iO);
+        invPerm = compCPerm(iP);
+    }
+
+#ifdef SIMD_X86
+    //apply the moves to 16 cubes at a time
+    __attribute__((target("avx512f")))
+    static uint32_t moveAvx512(const uint16_t tOri[][ORI_CASES + GATHER_PAD], const uint16_t tPerm[][PERM_CASES + GATHER_PAD],
+                               uint16_t ori[], uint16_t perm[], uint32_t n, const int8_t moves[], uint32_t nMoves) {
+        const __m512i mask = _mm512_set1_epi32(0xFFFF), zero = _mm512_setzero_si512();
+        const __mmask16 all = 0xFFFF;
+        __m512i o, p;
+        uint32_t i, j;
+
+        //the masked forms with a zero source, the plain ones start from an undefined register
+        for (i = 0; i+16 <= n; i+=16) {
+            o = _mm512_maskz_cvtepu16_epi32(all, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&ori[i])));
+            p = _mm512_maskz_cvtepu16_epi32(all, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&perm[i])));
+
+            for (j = 0; j < nMoves; j++) {
+                o = _mm512_and_si512(_mm512_mask_i32gather_epi32(zero, all, o, tOri[moves[j]], 2), mask);
+                p = _mm512_and_si512(_mm512_mask_i32gather_epi32(zero, all, p, tPerm[moves[j]], 2), mask);
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&ori[i]), _mm512_maskz_cvtepi32_epi16(all, o));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&perm[i]), _mm512_maskz_cvtepi32_epi16(all, p));
+        }
+
+        return i;
+    }
+
+    //apply the moves to 8 cubes at a time
+    __attribute__((target("avx2")))
+    static uint32_t moveAvx2(const uint16_t tOri[][ORI_CASES + GATHER_PAD], const uint16_t tPerm[][PERM_CASES + GATHER_PAD],
+                             uint16_t ori[], uint16_t perm[], uint32_t n, const int8_t moves[], uint32_t nMoves) {
+        const __m256i mask = _mm256_set1_epi32(0xFFFF);
+        __m256i o, p;
+        uint32_t i, j;
+
+        for (i = 0; i+8 <= n; i+=8) {
+            o = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&ori[i])));
+            p = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&perm[i])));
+
+            for (j = 0; j < nMoves; j++) {
+                o = _mm256_and_si256(_mm256_i32gather_epi32(reinterpret_cast<const int*>(tOri[moves[j]]), o, 2), mask);
+                p = _mm256_and_si256(_mm256_i32gather_epi32(reinterpret_cast<const int*>(tPerm[moves[j]]), p, 2), mask);
+            }
+
+            o = _mm256_permute4x64_epi64(_mm256_packus_epi32(o, o), 0x08);
+            p = _mm256_permute4x64_epi64(_mm256_packus_epi32(p, p), 0x08);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&ori[i]), _mm256_castsi256_si128(o));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&perm[i]), _mm256_castsi256_si128(p));
+        }
+
+        return i;
+    }
+#endif
+
+    void Coords::moveBatch(uint16_t ori[], uint16_t perm[], uint32_t n, int8_t move) const {
+        moveBatch(ori, perm, n, &move, 1);
+    }
+
+    void Coords::moveBatch(uint16_t ori[], uint16_t perm[], uint32_t n, const int8_t moves[], uint32_t nMoves) const {
+        uint32_t i, j;
+
+        i = 0;
+
+#ifdef SIMD_X86
+        if (hasAvx512())
+            i = moveAvx512(tOri, tPerm, ori, perm, n, moves, nMoves);
+        else if (hasAvx2())
+            i = moveAvx2(tOri, tPerm, ori, perm, n, moves, nMoves);
+#endif
+
+        for (; i < n; i++) {
+            for (j = 0; j < nMoves; j++) {
+                ori[i] = cOri[ori[i]][moves[j]];
+                perm[i] = cPerm[perm[i]][moves[j]];
+            }
+        }
     }
 
     void Coords::test() {
-        uint16_t i;
+        const int8_t moves[N_MOVES] = {R1_MOVE, U2_MOVE, F3_MOVE, U1_MOVE, R3_MOVE, F1_MOVE, R2_MOVE, F2_MOVE, U3_MOVE};
+        uint16_t i, o, p;
         int8_t j;
         int8_t cube[N_CORNERS];
+        uint16_t ori[PERM_CASES], perm[PERM_CASES];
 
         for(i = 0; i < ORI_CASES; i++){
             invCOri(cube, i);
@@ -168,6 +366,21 @@ namespace Solver2x2 {
             assert(compCPerm(cube) == i);
         }
 
+        for(i = 0; i < FULL_ORI_CASES; i++){
+            invFullOri(cube, i);
+            o = 0;
+
+            for(j = UFR; j <= DBR; j++)
+                o = (uint16_t)(o + cube[j]);
+
+            assert(comFullOri(cube) == i && o % C_STATES == 0);
+        }
+
+        for(i = 0; i < FULL_PERM_CASES; i++){
+            invFullPerm(cube, i);
+            assert(compFullPerm(cube) == i);
+        }
+
         for(i = 0; i < ORI_CASES; i++){
             for(j = 0; j < N_MOVES; j++) {
                 assert(moveCOri(moveCOri(i, j), invMove(j)) == i);
@@ -179,5 +392,39 @@ namespace Solver2x2 {
                 assert(moveCPerm(moveCPerm(i, j), invMove(j)) == i);
             }
         }
+
+        for(j = 0; j < N_MOVES; j++) {
+            for(i = 0; i < PERM_CASES; i++) {
+                ori[i] = (uint16_t)(i%ORI_CASES);
+                perm[i] = i;
+            }
+
+            moveBatch(ori, perm, PERM_CASES, j);
+            moveBatch(ori, perm, PERM_CASES, moves, N_MOVES);
+
+            for(i = 0; i < PERM_CASES; i++) {
+                o = moveCOri((uint16_t)(i%ORI_CASES), j);
+                p = moveCPerm(i, j);
+
+                for(int8_t k = 0; k < N_MOVES; k++) {
+                    o = moveCOri(o, moves[k]);
+                    p = moveCPerm(p, moves[k]);
+                }
+
+                assert(ori[i] == o && perm[i] == p);
+            }
+        }
+
+        for(i = 0; i < PERM_CASES; i++) {
+            o = (uint16_t)((i*7)%ORI_CASES);
+            inverse(o, i, ori[0], perm[0]);
+            compose(o, i, ori[0], perm[0], ori[1], perm[1]);
+            assert(ori[1] == 0 && perm[1] == 0);
+
+            for(j = 0; j < N_MOVES; j++) {
+                compose(o, i, moveCOri(0, j), moveCPerm(0, j), ori[1], perm[1]);
+                assert(ori[1] == moveCOri(o, j) && perm[1] == moveCPerm(i, j));
+            }
+        }
     }
 }
\ No newline at end of file
@@ -23,6 +23,24 @@
  */
 #define PERM_CASES 5040
 
+/**
+ * The corner orientation cases without a fixed corner,
+ * 7 corners are free and the last one follows: 3^7.
+ */
+#define FULL_ORI_CASES 2187
+
+/**
+ * The corner permutation cases without a fixed corner: 8!.
+ */
+#define FULL_PERM_CASES 40320
+
+/**
+ * Padding of the move major tables. The SIMD gathers read
+ * 32 bits for every 16 bits coordinate, so the last one
+ * needs a following element.
+ */
+#define GATHER_PAD 2
+
 namespace Solver2x2 {
 
     /**
@@ -46,6 +64,18 @@ namespace Solver2x2 {
          */
         uint16_t cPerm[PERM_CASES][N_MOVES]{};
 
+        /**
+         * The corner orientation matrix transposed, one row for every move.
+         * Its used by the batch moves.
+         */
+        uint16_t tOri[N_MOVES][ORI_CASES + GATHER_PAD]{};
+
+        /**
+         * The corner permutation matrix transposed, one row for every move.
+         * Its used by the batch moves.
+         */
+        uint16_t tPerm[N_MOVES][PERM_CASES + GATHER_PAD]{};
+
     public:
 
         /**
@@ -86,7 +116,6 @@ namespace Solver2x2 {
          */
         static uint16_t comCOri(const int8_t c[]);
 
-    private:
         /**
          * This function is the opposite of the precedent. It converts a coordinate
          * into the cube.
@@ -96,6 +125,8 @@ namespace Solver2x2 {
          */
         static void invCOri(int8_t c[], uint16_t coord);
 
+    private:
+
         //corner perm
 
         /**
@@ -123,7 +154,6 @@ namespace Solver2x2 {
          */
         static uint16_t compCPerm(int8_t c[]);
 
-    private:
         /**
          * This function is the opposite of the precedent. It converts a coordinate
          * into the cube.
@@ -133,7 +163,88 @@ namespace Solver2x2 {
          */
         static void invCPerm(int8_t c[], uint16_t coord);
 
-    public:
+        //all the corners, for the moves of every face
+
+        /**
+         * Compute the corner orient coordinate of all the 8 corners,
+         * only DBR is not counted because it follows the others.
+         *
+         * @param c         : The array that contains the orientation of corners.
+         * @return          : The coordinate, from 0 to FULL_ORI_CASES-1.
+         */
+        static uint16_t comFullOri(const int8_t c[]);
+
+        /**
+         * Convert a coordinate of all the corners into the cube.
+         *
+         * @param c         : The array to store the cube.
+         * @param coord     : The coordinate to convert.
+         */
+        static void invFullOri(int8_t c[], uint16_t coord);
+
+        /**
+         * Compute the corner perm coordinate of all the 8 corners.
+         *
+         * @param c         : The array that contains the order of corners.
+         * @return          : The coordinate, from 0 to FULL_PERM_CASES-1.
+         */
+        static uint16_t compFullPerm(const int8_t c[]);
+
+        /**
+         * Convert a coordinate of all the corners into the cube.
+         *
+         * @param c         : The array to store the cube.
+         * @param coord     : The coordinate to convert.
+         */
+        static void invFullPerm(int8_t c[], uint16_t coord);
+
+        /**
+         * Compose two cubes at cubie level. The result is the cube
+         * obtained applying to the cube a the moves that generate b.
+         *
+         * @param oriA      : Corner orientation of a.
+         * @param permA     : Corner permutation of a.
+         * @param oriB      : Corner orientation of b.
+         * @param permB     : Corner permutation of b.
+         * @param ori       : The corner orientation of the result.
+         * @param perm      : The corner permutation of the result.
+         */
+        static void compose(uint16_t oriA, uint16_t permA, uint16_t oriB, uint16_t permB, uint16_t& ori, uint16_t& perm);
+
+        /**
+         * Compute the inverse of a cube, the cube generated by the
+         * moves that solve it.
+         *
+         * @param ori       : Corner orientation.
+         * @param perm      : Corner permutation.
+         * @param invOri    : The corner orientation of the inverse.
+         * @param invPerm   : The corner permutation of the inverse.
+         */
+        static void inverse(uint16_t ori, uint16_t perm, uint16_t& invOri, uint16_t& invPerm);
+
+        /**
+         * Apply a move to a batch of cubes.
+         * It uses the AVX-512 or AVX2 gathers if the cpu supports them.
+         *
+         * @param ori       : The corner orientations, updated.
+         * @param perm      : The corner permutations, updated.
+         * @param n         : The number of cubes.
+         * @param move      : The move to apply.
+         */
+        void moveBatch(uint16_t ori[], uint16_t perm[], uint32_t n, int8_t move) const;
+
+        /**
+         * Apply a sequence of moves to a batch of cubes.
+         * Every group of cubes stays in the registers for the
+         * whole sequence.
+         *
+         * @param ori       : The corner orientations, updated.
+         * @param perm      : The corner permutations, updated.
+         * @param n         : The number of cubes.
+         * @param moves     : The moves to apply.
+         * @param nMoves    : The number of moves.
+         */
+        void moveBatch(uint16_t ori[], uint16_t perm[], uint32_t n, const int8_t moves[], uint32_t nMoves) const;
 
         /**
          * Test if the coords generator works correctly.
@@ -0,0 +1,289 @@
+/**
+ * This file contains the class CornerDB.
+ * It is the pattern database of the corners of the 3x3 cube.
+ */
+
+#include <fstream>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+#include "CornerDB.h"
+#include "Explore.h"
+
+namespace Solver2x2{
+
+    //the first bytes of the file
+    static const char CORNER_MAGIC[4] = {'S', '2', 'C', '1'};
+
+    //the header: the magic, the states and the depths
+    #define CORNER_HEADER 16
+
+    //the bytes of the depths
+    #define CORNER_BYTES (CORNER_CASES / 2)
+
+    //generate the move tables
+    CornerDB::CornerDB(){
+        int8_t cube[N_CORNERS], cube2[N_CORNERS];
+        uint16_t i;
+        int8_t j;
+
+        for(i = 0; i < FULL_ORI_CASES; i++){
+            Coords::invFullOri(cube, i);
+
+            for(j = 0; j < N_FACE_MOVES; j++){
+                memcpy(cube2, cube, N_CORNERS);
+                moveOri(cube2, j);
+                mOri[i][j] = Coords::comFullOri(cube2);
+            }
+        }
+
+        for(i = 0; i < FULL_PERM_CASES; i++){
+            Coords::invFullPerm(cube, i);
+
+            for(j = 0; j < N_FACE_MOVES; j++){
+                memcpy(cube2, cube, N_CORNERS);
+                movePerm(cube2, j);
+                mPerm[i][j] = Coords::compFullPerm(cube2);
+            }
+        }
+    }
+
+    //unmap the file
+    CornerDB::~CornerDB(){
+        release();
+    }
+
+    //deallocate the depths
+    void CornerDB::release(){
+        mapped.close();
+        depths = nullptr;
+        generated = std::vector<uint8_t>();
+    }
+
+    //move the cubes of the depth, the next ones can be in every range
+    void CornerDB::expand(uint8_t table[], int8_t depth, uint16_t begin, uint16_t end, uint32_t& found) const{
+        const auto next = (uint8_t)(depth + 1);
+        uint32_t p, n, count = 0;
+        uint16_t o;
+        uint8_t old, shift;
+        int8_t m;
+
+        for(o = begin; o < end; o++){
+            const uint8_t* row = &table[(uint32_t)o * FULL_PERM_CASES / 2];
+
+            for(p = 0; p < FULL_PERM_CASES; p++){
+                if(((__atomic_load_n(&row[p >> 1], __ATOMIC_RELAXED) >> ((p & 1) << 2)) & 0xF) != depth)
+                    continue;
+
+                for(m = 0; m < N_FACE_MOVES; m++){
+                    n = (uint32_t)mOri[o][m] * FULL_PERM_CASES + mPerm[p][m];
+                    shift = (uint8_t)((n & 1) << 2);
+                    old = __atomic_load_n(&table[n >> 1], __ATOMIC_RELAXED);
+
+                    //the other half of the byte can change at the same time
+                    while(((old >> shift) & 0xF) == CORNER_UNKNOWN){
+                        if(__atomic_compare_exchange_n(&table[n >> 1], &old, (uint8_t)((old & ~(0xF << shift)) | next << shift),
+                                                       true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+                            count++;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        found = count;
+    }
+
+    //check the unvisited cubes of the range, only this thread writes them
+    void CornerDB::check(uint8_t table[], int8_t depth, uint16_t begin, uint16_t end, uint32_t& found) const{
+        const auto next = (uint8_t)(depth + 1);
+        uint32_t p, n, count = 0;
+        uint16_t o;
+        uint8_t byte, half;
+        int8_t m;
+
+        for(o = begin; o < end; o++){
+            uint8_t* row = &table[(uint32_t)o * FULL_PERM_CASES / 2];
+
+            for(p = 0; p < FULL_PERM_CASES; p += 2){
+                byte = row[p >> 1];
+
+                if((byte & 0xF) != CORNER_UNKNOWN && (byte >> 4) != CORNER_UNKNOWN)
+                    continue;
+
+                for(half = 0; half < 2; half++){
+                    if(((byte >> (half << 2)) & 0xF) != CORNER_UNKNOWN)
+                        continue;
+
+                    for(m = 0; m < N_FACE_MOVES; m++){
+                        n = (uint32_t)mOri[o][m] * FULL_PERM_CASES + mPerm[p + half][m];
+
+                        if(((__atomic_load_n(&table[n >> 1], __ATOMIC_RELAXED) >> ((n & 1) << 2)) & 0xF) == depth){
+                            byte = (uint8_t)((byte & ~(0xF << (half << 2))) | next << (half << 2));
+                            count++;
+                            break;
+                        }
+                    }
+                }
+
+                __atomic_store_n(&row[p >> 1], byte, __ATOMIC_RELAXED);
+            }
+        }
+
+        found = count;
+    }
+
+    //breadth first search from the solved corners
+    bool CornerDB::generate(uint32_t threads, uint32_t sizes[CORNER_DEPTHS]){
+        std::vector<std::thread> workers;
+        std::vector<uint32_t> found;
+        uint32_t t, size, total, unknown;
+        uint8_t* table;
+        int8_t d;
+
+        release();
+
+        if(threads == 0)
+            threads = 1;
+
+        generated.assign(CORNER_BYTES, 0xFF);
+        table = generated.data();
+        depths = table;
+        found.resize(threads);
+
+        //the solved corners have index 0
+        table[0] = 0xF0;
+        sizes[0] = total = 1;
+        size = (FULL_ORI_CASES + threads - 1) / threads;
+
+        for(d = 0; d + 1 < CORNER_DEPTHS; d++){
+            unknown = CORNER_CASES - total;
+            workers.clear();
+
+            //a big depth is faster from the unvisited cubes
+            for(t = 0; t < threads; t++)
+                workers.emplace_back(sizes[d] > unknown / 4 ? &CornerDB::check : &CornerDB::expand, this, table, d,
+                                     (uint16_t)std::min(t*size, (uint32_t)FULL_ORI_CASES),
+                                     (uint16_t)std::min((t+1)*size, (uint32_t)FULL_ORI_CASES), std::ref(found[t]));
+
+            sizes[d+1] = 0;
+
+            for(t = 0; t < threads; t++){
+                workers[t].join();
+                sizes[d+1] += found[t];
+            }
+
+            total += sizes[d+1];
+        }
+
+        return total == CORNER_CASES;
+    }
+
+    //the header and the depths, the file can be the mapped one
+    bool CornerDB::write(const std::string& name) const{
+        std::ofstream file;
+        uint32_t header[CORNER_HEADER / sizeof(uint32_t)] = {0, CORNER_CASES, CORNER_DEPTHS, 0};
+
+        if(depths == nullptr)
+            return false;
+
+        //the lookups of the published table still read the old file
+        file.open(MappedFile::temporary(name), std::ios::binary);
+
+        if(!file)
+            return false;
+
+        memcpy(header, CORNER_MAGIC, sizeof(CORNER_MAGIC));
+        file.write(reinterpret_cast<const char *>(header), CORNER_HEADER);
+        file.write(reinterpret_cast<const char *>(depths), CORNER_BYTES);
+        file.close();
+
+        return MappedFile::replace(name, !file.fail());
+    }
+
+    //map the file, the pages are read when they are used
+    bool CornerDB::load(const std::string& name){
+        release();
+
+        if(!mapped.open(name) || mapped.size() != CORNER_HEADER + (size_t)CORNER_BYTES ||
+           memcmp(mapped.bytes(), CORNER_MAGIC, sizeof(CORNER_MAGIC)) != 0){
+            release();
+            return false;
+        }
+
+        depths = mapped.bytes() + CORNER_HEADER;
+
+        return true;
+    }
+
+    //the lookups of the next states are started before they are needed
+    void CornerDB::get(const uint32_t idx[], int8_t res[], uint32_t n) const{
+        uint32_t i;
+
+        for(i = 0; i < n; i++){
+#if defined(__GNUC__)
+            if(i + PREFETCH_DISTANCE < n && idx[i + PREFETCH_DISTANCE] < CORNER_CASES)
+                __builtin_prefetch(&depths[idx[i + PREFETCH_DISTANCE] >> 1]);
+#endif
+            res[i] = idx[i] < CORNER_CASES ? get(idx[i]) : (int8_t)-1;
+        }
+    }
+
+    //move the two coordinates
+    uint32_t CornerDB::move(uint32_t idx, int8_t move) const{
+        return (uint32_t)mOri[idx / FULL_PERM_CASES][move] * FULL_PERM_CASES + mPerm[idx % FULL_PERM_CASES][move];
+    }
+
+    //every corner once and the twists with a sum multiple of 3
+    uint32_t CornerDB::index(const int8_t perm[], const int8_t ori[]){
+        bool seen[N_CORNERS] = {};
+        int8_t i, sum = 0;
+
+        for(i = UFR; i <= DBR; i++){
+            if(perm[i] < UFR || perm[i] > DBR || seen[perm[i]] || ori[i] < 0 || ori[i] >= C_STATES)
+                return NO_CUBE;
+
+            seen[perm[i]] = true;
+            sum = (int8_t)(sum + ori[i]);
+        }
+
+        if(sum % C_STATES != 0)
+            return NO_CUBE;
+
+        return (uint32_t)Coords::comFullOri(ori) * FULL_PERM_CASES + Coords::compFullPerm(perm);
+    }
+
+    //every move and its inverse, and the solved corners
+    void CornerDB::test() const{
+        int8_t perm[N_CORNERS], ori[N_CORNERS];
+        uint32_t i;
+        int8_t m;
+
+        for(i = 0; i < N_CORNERS; i++){
+            perm[i] = (int8_t)i;
+            ori[i] = DEFAULT_C;
+        }
+
+        assert(index(perm, ori) == 0);
+
+        for(m = 0; m < N_FACE_MOVES; m++){
+            assert(move(0, m) != 0);
+            assert(move(move(0, m), invMove(m)) == 0);
+        }
+
+        for(i = 0; i < CORNER_CASES; i += 99991){
+            for(m = 0; m < N_FACE_MOVES; m++){
+                assert(move(i, m) < CORNER_CASES && move(move(i, m), invMove(m)) == i);
+            }
+
+            Coords::invFullOri(ori, (uint16_t)(i / FULL_PERM_CASES));
+            Coords::invFullPerm(perm, (uint16_t)(i % FULL_PERM_CASES));
+            assert(index(perm, ori) == i);
+        }
+
+        perm[UFR] = perm[UFL];
+        assert(index(perm, ori) == NO_CUBE);
+    }
+}
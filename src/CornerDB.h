@@ -0,0 +1,180 @@
+/**
+ * This file contains the class CornerDB.
+ * It is the pattern database of the corners of the 3x3 cube:
+ * the depth of every corner state with the 18 moves of all the
+ * faces, no corner is fixed. The 3x3 solvers use it as the
+ * heuristic of the search, the cube needs at least the moves
+ * of its corners.
+ *
+ * The index of a state is ori × FULL_PERM_CASES + perm and the
+ * depths are stored in 4 bits, the even index in the low bits.
+ *
+ * The generation is a breadth first search by depth, in more
+ * threads. The first depths move the cubes of the last depth, the
+ * others check the unvisited cubes and take the depth if one of
+ * the next cubes is on the last depth, so they never write the
+ * bytes of the other threads.
+ *
+ * The file has a header and the depths, it is mapped in memory.
+ */
+
+#ifndef SOLVER2X2_CXX_CORNERDB_H
+#define SOLVER2X2_CXX_CORNERDB_H
+
+#include <vector>
+#include <string>
+#include "Solver2x2.h"
+#include "Coords.h"
+#include "MappedFile.h"
+
+/**
+ * The number of corner states: 8!×3^7.
+ */
+#define CORNER_CASES 88179840u
+
+/**
+ * The most moves of a corner state.
+ */
+#define CORNER_DEPTHS 12
+
+/**
+ * The depth of a state not visited yet.
+ */
+#define CORNER_UNKNOWN 0xF
+
+namespace Solver2x2{
+
+    /**
+     * Class CornerDB
+     * The corner pattern database, 42 MB (8!×3^7÷2÷1024÷1024).
+     */
+    class CornerDB{
+    private:
+
+        ///the orientation moved by the 18 moves
+        uint16_t mOri[FULL_ORI_CASES][N_FACE_MOVES]{};
+
+        ///the permutation moved by the 18 moves
+        uint16_t mPerm[FULL_PERM_CASES][N_FACE_MOVES]{};
+
+        ///the depths, in the generated memory or in the mapped file
+        const uint8_t* depths = nullptr;
+
+        ///the generated depths
+        std::vector<uint8_t> generated;
+
+        ///the mapped file
+        MappedFile mapped;
+
+        /**
+         * Move the cubes of a depth, from the first threads.
+         *
+         * @param table     : The depths.
+         * @param depth     : The depth to move.
+         * @param begin     : The first orientation.
+         * @param end       : The orientation after the last.
+         * @param found     : The number of cubes found.
+         */
+        void expand(uint8_t table[], int8_t depth, uint16_t begin, uint16_t end, uint32_t& found) const;
+
+        /**
+         * Check the unvisited cubes, from the last threads.
+         *
+         * @param table     : The depths.
+         * @param depth     : The depth of the previous cubes.
+         * @param begin     : The first orientation.
+         * @param end       : The orientation after the last.
+         * @param found     : The number of cubes found.
+         */
+        void check(uint8_t table[], int8_t depth, uint16_t begin, uint16_t end, uint32_t& found) const;
+
+        /**
+         * Deallocate the depths.
+         */
+        void release();
+
+    public:
+
+        /**
+         * Generate the move tables.
+         */
+        CornerDB();
+
+        /**
+         * Unmap the file.
+         */
+        ~CornerDB();
+
+        CornerDB(const CornerDB&) = delete;
+        CornerDB& operator=(const CornerDB&) = delete;
+
+        /**
+         * Generate the depths.
+         *
+         * @param threads   : The number of threads.
+         * @param sizes     : The number of cubes of every depth.
+         * @return          : True if all the states are found.
+         */
+        bool generate(uint32_t threads, uint32_t sizes[CORNER_DEPTHS]);
+
+        /**
+         * Write the depths into a file.
+         *
+         * @param name      : The name of the file.
+         * @return          : True if the file is written.
+         */
+        bool write(const std::string& name) const;
+
+        /**
+         * Map a file in memory.
+         *
+         * @param name      : The name of the file.
+         * @return          : True if the file is correct.
+         */
+        bool load(const std::string& name);
+
+        /**
+         * Get the depth of a state.
+         *
+         * @param idx       : The index of the state.
+         * @return          : The moves to solve the corners.
+         */
+        int8_t get(uint32_t idx) const{
+            return (int8_t)((depths[idx >> 1] >> ((idx & 1) << 2)) & 0xF);
+        }
+
+        /**
+         * Get the depths of a batch of states.
+         *
+         * @param idx       : The indexes, NO_CUBE for no state.
+         * @param res       : The depths, -1 for no state.
+         * @param n         : The number of states.
+         */
+        void get(const uint32_t idx[], int8_t res[], uint32_t n) const;
+
+        /**
+         * Apply a move to a state.
+         *
+         * @param idx       : The index of the state.
+         * @param move      : The move, from 0 to N_FACE_MOVES-1.
+         * @return          : The index of the new state.
+         */
+        uint32_t move(uint32_t idx, int8_t move) const;
+
+        /**
+         * Compute the index of the corners.
+         *
+         * @param perm      : The corner in every position.
+         * @param ori       : The twist of every position.
+         * @return          : The index, NO_CUBE if the corners are not valid.
+         */
+        static uint32_t index(const int8_t perm[], const int8_t ori[]);
+
+        /**
+         * Test the moves and the index.
+         */
+        void test() const;
+    };
+}
+
+#endif //SOLVER2X2_CXX_CORNERDB_H
@@ -0,0 +1,149 @@
+/**
+ * This file contains the class Costs.
+ * It chooses among the optimal solutions of every cube
+ * the one with the least cost.
+ */
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "Costs.h"
+
+namespace Solver2x2{
+
+    //set the solutions and the costs
+    Costs::Costs(Explore::Scramble* scramble, Coords& coords, const MoveCosts& costs) :
+            scramble(scramble), coords(coords), costs(costs){}
+
+    //move the coordinates of an index
+    uint32_t Costs::move(uint32_t idx, int8_t move) const{
+        return Explore::Scramble::index(coords.moveCOri((uint16_t)(idx / PERM_CASES), move),
+                                        coords.moveCPerm((uint16_t)(idx % PERM_CASES), move));
+    }
+
+    //the least costs of the cubes of a depth, from the previous depth
+    void Costs::findRange(const Depths* depths, int8_t depth, uint32_t begin, uint32_t end){
+        uint32_t i, idx, parent, best, c;
+        int8_t m, m2;
+
+        for(i = begin; i < end; i++){
+            idx = depths->get(depth, i);
+
+            for(m = 0; m < N_MOVES; m++){
+                parent = move(idx, m);
+                best = depth == 1 ? 0 : UINT32_MAX;
+
+                //only the moves that lower the depth
+                if(Explore::Scramble::depth(scramble->scrambleArray[parent]) != depth - 1){
+                    least[idx * N_MOVES + m] = NO_COST;
+                    continue;
+                }
+
+                for(m2 = 0; depth > 1 && m2 < N_MOVES; m2++)
+                    if(least[parent * N_MOVES + m2] != NO_COST)
+                        best = std::min(best, costs.pair[m][m2] + (uint32_t)least[parent * N_MOVES + m2]);
+
+                //the costs over the limit are equal
+                c = std::min(costs.move[m] + best, (uint32_t)NO_COST - 1);
+                least[idx * N_MOVES + m] = (uint16_t)c;
+            }
+        }
+    }
+
+    //the move with the least cost after the previous one, the first move on a tie
+    int8_t Costs::next(uint32_t idx, int8_t prev) const{
+        uint32_t c, best = UINT32_MAX;
+        int8_t m, res = 0;
+
+        for(m = 0; m < N_MOVES; m++){
+            if(least[idx * N_MOVES + m] == NO_COST)
+                continue;
+
+            c = least[idx * N_MOVES + m] + (prev == NO_MOVE ? 0 : costs.pair[prev][m]);
+
+            if(c < best){
+                best = c;
+                res = m;
+            }
+        }
+
+        return res;
+    }
+
+    //follow the least costs to the solved cube
+    void Costs::rebuildRange(uint32_t begin, uint32_t end){
+        uint32_t i, idx;
+        uint64_t res;
+        int8_t d, k, m;
+
+        for(i = begin; i < end; i++){
+            d = Explore::Scramble::depth(scramble->scrambleArray[i]);
+            res = (uint64_t)d;
+            idx = i;
+            m = NO_MOVE;
+
+            for(k = 0; k < d; k++){
+                m = next(idx, m);
+                res |= (uint64_t)m << (4 * (k + 1));
+                idx = move(idx, m);
+            }
+
+            scramble->scrambleArray[i] = res;
+        }
+    }
+
+    //one depth at time, the threads split the cubes of the depth
+    void Costs::choose(uint32_t threads){
+        std::vector<std::thread> workers;
+        uint32_t t, n, size;
+        int8_t d;
+
+        if(threads == 0)
+            threads = 1;
+
+        least.assign((size_t)CUBE_CASES * N_MOVES, NO_COST);
+
+        {
+            Depths depths(scramble);
+
+            for(d = 1; d < MAX_DEPTH; d++){
+                n = depths.size(d);
+                size = (n + threads - 1) / threads;
+                workers.clear();
+
+                for(t = 0; t < threads; t++)
+                    workers.emplace_back(&Costs::findRange, this, &depths, d, std::min(t*size, n), std::min((t+1)*size, n));
+
+                for(std::thread& worker : workers)
+                    worker.join();
+            }
+        }
+
+        //the solutions are rebuilt when all the least costs are known
+        size = (CUBE_CASES + threads - 1) / threads;
+        workers.clear();
+
+        for(t = 0; t < threads; t++)
+            workers.emplace_back(&Costs::rebuildRange, this, std::min(t*size, (uint32_t)CUBE_CASES),
+                                 std::min((t+1)*size, (uint32_t)CUBE_CASES));
+
+        for(std::thread& worker : workers)
+            worker.join();
+
+        least = std::vector<uint16_t>();
+    }
+
+    //the moves and the pairs
+    uint32_t Costs::cost(uint64_t moves, const MoveCosts& costs){
+        int8_t d = Explore::Scramble::depth(moves), k, m, prev = NO_MOVE;
+        uint32_t res = 0;
+
+        for(k = 0; k < d; k++){
+            m = (int8_t)((moves >> (4 * (k + 1))) & 0xF);
+            res += costs.move[m] + (prev == NO_MOVE ? 0 : costs.pair[prev][m]);
+            prev = m;
+        }
+
+        return res;
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * This file contains the class Costs.
+ * Most cubes have many optimal solutions, the generation keeps
+ * the first one it finds. This class chooses again, among the
+ * optimal solutions of every cube, the one with the least cost
+ * for the hands, so the table keeps its format and the solve
+ * its time.
+ *
+ * The cost of a solution is the cost of every move plus the cost
+ * of every move after the previous one. The least cost of the
+ * solutions of a cube starting with a move is found from the cubes
+ * of the previous depth, one depth at time and in more threads:
+ *
+ * cost(cube, m) = move[m] + min over m' (pair[m][m'] + cost(cube after m, m'))
+ *
+ * with m that lowers the depth. Then the solutions are rebuilt
+ * following the least costs.
+ */
+
+#ifndef SOLVER2X2_CXX_COSTS_H
+#define SOLVER2X2_CXX_COSTS_H
+
+#include "Explore.h"
+#include "Depths.h"
+
+/**
+ * The cost of the moves that do not lower the depth,
+ * also the limit of the cost of a solution.
+ */
+#define NO_COST UINT16_MAX
+
+namespace Solver2x2{
+
+    /**
+     * Class Costs
+     * The least costs of every cube and every first move,
+     * 63 MB (7!×3^6×9×2÷1024÷1024) during the choice.
+     */
+    class Costs{
+    private:
+
+        ///the solutions to choose again
+        Explore::Scramble* scramble;
+
+        ///the coords to move the cubes
+        Coords& coords;
+
+        ///the costs of the moves
+        const MoveCosts& costs;
+
+        ///the least cost of every cube for every first move
+        std::vector<uint16_t> least;
+
+        /**
+         * Find the least costs of the cubes of a depth in a range.
+         *
+         * @param depths    : The cubes grouped by depth.
+         * @param depth     : The depth of the cubes.
+         * @param begin     : The first position in the depth.
+         * @param end       : The position after the last one.
+         */
+        void findRange(const Depths* depths, int8_t depth, uint32_t begin, uint32_t end);
+
+        /**
+         * Rebuild the solutions of a range of cubes.
+         *
+         * @param begin     : The first index.
+         * @param end       : The index after the last one.
+         */
+        void rebuildRange(uint32_t begin, uint32_t end);
+
+        /**
+         * Get the next move with the least cost.
+         *
+         * @param idx       : The index of the cube.
+         * @param prev      : The previous move, NO_MOVE for the first one.
+         * @return          : The move.
+         */
+        int8_t next(uint32_t idx, int8_t prev) const;
+
+        /**
+         * Apply a move to a cube.
+         *
+         * @param idx       : The index of the cube.
+         * @param move      : The move.
+         * @return          : The index of the new cube.
+         */
+        uint32_t move(uint32_t idx, int8_t move) const;
+
+    public:
+
+        /**
+         * Set the solutions and the costs.
+         *
+         * @param scramble  : The optimal solutions, changed by choose.
+         * @param coords    : The coords to move the cubes.
+         * @param costs     : The costs of the moves.
+         */
+        Costs(Explore::Scramble* scramble, Coords& coords, const MoveCosts& costs);
+
+        /**
+         * Choose the solution with the least cost of every cube.
+         *
+         * @param threads   : The number of threads.
+         */
+        void choose(uint32_t threads);
+
+        /**
+         * Get the cost of a solution.
+         *
+         * @param moves     : The compressed scramble.
+         * @param costs     : The costs of the moves.
+         * @return          : The cost.
+         */
+        static uint32_t cost(uint64_t moves, const MoveCosts& costs);
+    };
+}
+
+#endif //SOLVER2X2_CXX_COSTS_H
@@ -0,0 +1,228 @@
+/**
+ * This file contains the class DepthFile.
+ * It writes the cubes grouped by depth into a file and reads
+ * them in background, a depth at time.
+ */
+
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include "DepthFile.h"
+#include "Depths.h"
+
+namespace Solver2x2{
+
+    //the first bytes of the file
+    static const char DEPTH_MAGIC[4] = {'S', '2', 'D', '1'};
+
+    //create the reader
+    DepthFile::DepthFile(Explore::Scramble* scramble) : scramble(scramble){}
+
+    //stop the reader
+    DepthFile::~DepthFile(){
+        stop = true;
+
+        if(reader.joinable())
+            reader.join();
+    }
+
+    //write the file
+    bool DepthFile::write(const Explore::Scramble* scramble, const std::string& name){
+        std::ofstream file(name, std::ios::binary);
+        std::vector<uint32_t> records;
+        uint32_t sizes[MAX_DEPTH];
+        uint32_t i, idx;
+        int8_t d;
+
+        if(!file)
+            return false;
+
+        Depths depths(scramble);
+
+        for(d = 0; d < MAX_DEPTH; d++)
+            sizes[d] = depths.size(d);
+
+        file.write(DEPTH_MAGIC, sizeof(DEPTH_MAGIC));
+        file.write(reinterpret_cast<const char *>(sizes), sizeof(sizes));
+
+        //the first move is after the number of moves
+        for(d = 0; d < MAX_DEPTH; d++){
+            records.resize(sizes[d]);
+
+            for(i = 0; i < sizes[d]; i++){
+                idx = depths.get(d, i);
+                records[i] = (idx << 4) | (uint32_t)((scramble->scrambleArray[idx] >> 4) & 0xF);
+            }
+
+            file.write(reinterpret_cast<const char *>(records.data()), sizeof(uint32_t) * sizes[d]);
+        }
+
+        return (bool)file;
+    }
+
+    //check the file and start the reader
+    bool DepthFile::open(const std::string& name){
+        std::ifstream file(name, std::ios::binary | std::ios::ate);
+        char magic[sizeof(DEPTH_MAGIC)];
+        uint64_t total = 0;
+        int8_t d;
+
+        if(!file)
+            return false;
+
+        if((uint64_t)file.tellg() != sizeof(DEPTH_MAGIC) + sizeof(sizes) + sizeof(uint32_t) * (uint64_t)CUBE_CASES)
+            return false;
+
+        file.seekg(0);
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char *>(sizes), sizeof(sizes));
+
+        if(!file || memcmp(magic, DEPTH_MAGIC, sizeof(magic)) != 0 || sizes[0] != 1)
+            return false;
+
+        for(d = 0; d < MAX_DEPTH; d++)
+            total += sizes[d];
+
+        if(total != CUBE_CASES)
+            return false;
+
+        //the cubes not read yet are recognized by the solve
+        std::fill(scramble->scrambleArray, scramble->scrambleArray + CUBE_CASES, NOT_LOADED);
+
+        reader = std::thread(&DepthFile::load, this, name);
+
+        return true;
+    }
+
+    //read the depths
+    void DepthFile::load(std::string name){
+        std::ifstream file(name, std::ios::binary);
+        std::vector<uint32_t> records(LOAD_BLOCK);
+        uint64_t* s = scramble->scrambleArray;
+        uint64_t prev;
+        uint32_t i, j, n, idx;
+        uint16_t ori, perm;
+        int8_t d, move;
+
+        file.seekg(sizeof(DEPTH_MAGIC) + sizeof(sizes));
+
+        for(d = 0; d < MAX_DEPTH; d++){
+            for(i = 0; i < sizes[d]; i += n){
+                n = std::min((uint32_t)LOAD_BLOCK, sizes[d] - i);
+                file.read(reinterpret_cast<char *>(records.data()), sizeof(uint32_t) * n);
+
+                if(!file || stop){
+                    repair(d);
+                    return;
+                }
+
+                for(j = 0; j < n; j++){
+                    idx = records[j] >> 4;
+                    move = (int8_t)(records[j] & 0xF);
+
+                    //every cube once
+                    if(idx >= CUBE_CASES || (d > 0 && move >= N_MOVES) || s[idx] != NOT_LOADED){
+                        repair(d);
+                        return;
+                    }
+
+                    //the solution is the first move and the solution of the cube it gives
+                    if(d == 0)
+                        prev = 0;
+                    else{
+                        ori = coords.moveCOri((uint16_t)(idx / PERM_CASES), move);
+                        perm = coords.moveCPerm((uint16_t)(idx % PERM_CASES), move);
+                        prev = s[Explore::Scramble::index(ori, perm)];
+
+                        if(prev == NOT_LOADED || Explore::Scramble::depth(prev) != d - 1){
+                            repair(d);
+                            return;
+                        }
+                    }
+
+                    __atomic_store_n(&s[idx], (((prev >> 4 << 4) | (uint64_t)move) << 4) | (uint64_t)d, __ATOMIC_RELAXED);
+                }
+            }
+
+            publish((int8_t)(d + 1), d + 1 == MAX_DEPTH);
+        }
+    }
+
+    //generate the whole table again, the solves wait it like the next depths
+    void DepthFile::repair(int8_t depths){
+        Explore::Scramble* generated;
+        uint32_t i;
+
+        if(stop){
+            publish(depths, true);
+            return;
+        }
+
+        failed.store(true, std::memory_order_release);
+        generated = new Explore::Scramble();
+
+        {
+            Explore explore(coords, generated);
+
+            if(!explore.generate()){
+                delete generated;
+                publish(depths, true);
+                return;
+            }
+        }
+
+        for(i = 0; i < CUBE_CASES; i++)
+            __atomic_store_n(&scramble->scrambleArray[i], generated->scrambleArray[i], __ATOMIC_RELAXED);
+
+        delete generated;
+        publish(MAX_DEPTH, true);
+    }
+
+    //publish the depths
+    void DepthFile::publish(int8_t depths, bool end){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            loaded.store(depths, std::memory_order_release);
+            done.store(end, std::memory_order_release);
+        }
+
+        ready.notify_all();
+    }
+
+    //solve a cube
+    uint64_t DepthFile::solve(uint32_t idx){
+        uint64_t res;
+        int8_t n;
+        bool end;
+
+        for(;;){
+            n = loaded.load(std::memory_order_acquire);
+            end = done.load(std::memory_order_acquire);
+            res = __atomic_load_n(&scramble->scrambleArray[idx], __ATOMIC_RELAXED);
+
+            if(res != NOT_LOADED || end)
+                return res;
+
+            //wait the next depth
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [&]{ return loaded.load() != n || done.load(); });
+        }
+    }
+
+    //wait the reader
+    void DepthFile::wait(){
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [&]{ return done.load(); });
+    }
+
+    //depths ready
+    int8_t DepthFile::depths() const{
+        return loaded.load(std::memory_order_acquire);
+    }
+
+    //file broken
+    bool DepthFile::broken() const{
+        return failed.load(std::memory_order_acquire);
+    }
+}
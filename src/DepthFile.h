@@ -0,0 +1,159 @@
+/**
+ * This file contains the class DepthFile.
+ * It writes the cubes grouped by depth into a file and reads
+ * them in background, a depth at time. Every depth can be used
+ * as soon as it is read, so the short solutions are ready in
+ * few milliseconds, before the whole table.
+ *
+ * The file has the number of cubes of every depth and then
+ * a record for every cube, ordered by depth:
+ *
+ * index of the cube << 4 | first move of the solution
+ *
+ * The solution is rebuilt with the cube of the previous depth.
+ *
+ * If the records are broken the reader generates the whole table
+ * again, the solves of the depths not read wait it.
+ */
+
+#ifndef SOLVER2X2_CXX_DEPTHFILE_H
+#define SOLVER2X2_CXX_DEPTHFILE_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Explore.h"
+
+/**
+ * The value of a cube not read yet.
+ */
+#define NOT_LOADED UINT64_MAX
+
+/**
+ * The records read at time.
+ */
+#define LOAD_BLOCK 65536
+
+namespace Solver2x2{
+
+    /**
+     * Class DepthFile
+     * The reader of the file ordered by depth. 15 MB
+     * (7!×3^6×4÷1024÷1024) on disk.
+     */
+    class DepthFile{
+    private:
+
+        ///the scrambles filled by the reader
+        Explore::Scramble* scramble;
+
+        ///the coords to rebuild the solutions
+        Coords coords;
+
+        ///the number of cubes of every depth
+        uint32_t sizes[MAX_DEPTH]{};
+
+        ///the depths ready
+        std::atomic<int8_t> loaded{0};
+
+        ///true when the reader ended, also with an error
+        std::atomic<bool> done{false};
+
+        ///true to stop the reader
+        std::atomic<bool> stop{false};
+
+        ///true if the records were broken
+        std::atomic<bool> failed{false};
+
+        ///lock and condition to wait a depth
+        std::mutex mutex;
+        std::condition_variable ready;
+
+        ///the reader
+        std::thread reader;
+
+        /**
+         * Read all the depths, run by the reader thread.
+         *
+         * @param name      : The name of the file.
+         */
+        void load(std::string name);
+
+        /**
+         * Generate the table when the file is broken, run by the reader thread.
+         *
+         * @param depths    : The number of depths read correctly.
+         */
+        void repair(int8_t depths);
+
+        /**
+         * Publish the depths read.
+         *
+         * @param depths    : The number of depths ready.
+         * @param end       : True if the reader ended.
+         */
+        void publish(int8_t depths, bool end);
+
+    public:
+
+        /**
+         * Create the reader.
+         *
+         * @param scramble  : The scrambles to fill.
+         */
+        explicit DepthFile(Explore::Scramble* scramble);
+
+        /**
+         * Stop the reader.
+         */
+        ~DepthFile();
+
+        /**
+         * Write the scrambles grouped by depth into a file.
+         *
+         * @param scramble  : The scrambles to write.
+         * @param name      : The name of the file.
+         * @return          : True if the file is written.
+         */
+        static bool write(const Explore::Scramble* scramble, const std::string& name);
+
+        /**
+         * Check the file and start the reader.
+         *
+         * @param name      : The name of the file.
+         * @return          : True if the file is correct.
+         */
+        bool open(const std::string& name);
+
+        /**
+         * Return the solve moves of a cube, it waits
+         * until the depth of the cube is read.
+         *
+         * @param idx       : The index of the cube.
+         * @return          : The compressed scramble, NOT_LOADED if the file is broken.
+         */
+        uint64_t solve(uint32_t idx);
+
+        /**
+         * Wait the end of the reader.
+         */
+        void wait();
+
+        /**
+         * Get the number of depths ready.
+         *
+         * @return          : The depths from 0 that can be solved.
+         */
+        int8_t depths() const;
+
+        /**
+         * Check if the records were broken.
+         *
+         * @return          : True if the table was generated instead of read.
+         */
+        bool broken() const;
+    };
+}
+
+#endif //SOLVER2X2_CXX_DEPTHFILE_H
@@ -0,0 +1,80 @@
+/**
+ * This file contains the class Depths.
+ * It groups the indexes of all the cubes by the number
+ * of moves to solve them, so a cube with a particular
+ * number of moves can be found without searching.
+ */
+
+#include <vector>
+#include "Depths.h"
+
+namespace Solver2x2{
+
+    //group by depth
+    Depths::Depths(const Explore::Scramble* scramble){
+        uint32_t pos[MAX_DEPTH];
+        uint32_t hist[MAX_DEPTH];
+        uint32_t i;
+        int8_t d;
+
+        idx = new uint32_t[CUBE_CASES];
+
+        scramble->histogram(hist);
+
+        for(d = 0; d < MAX_DEPTH; d++){
+            start[d+1] = start[d] + hist[d];
+            pos[d] = start[d];
+        }
+
+        for(i = 0; i < CUBE_CASES; i++)
+            idx[pos[Explore::Scramble::depth(scramble->scrambleArray[i])]++] = i;
+    }
+
+    //group by the depths of a table
+    Depths::Depths(TableBackend* backend){
+        std::vector<int8_t> depth(CUBE_CASES);
+        uint32_t pos[MAX_DEPTH];
+        uint32_t hist[MAX_DEPTH]{};
+        uint32_t i;
+        int8_t d;
+
+        idx = new uint32_t[CUBE_CASES];
+
+        //the indexes are the batch, then they are sorted in place
+        for(i = 0; i < CUBE_CASES; i++)
+            idx[i] = i;
+
+        backend->depth(idx, depth.data(), CUBE_CASES);
+
+        for(i = 0; i < CUBE_CASES; i++)
+            hist[depth[i]]++;
+
+        for(d = 0; d < MAX_DEPTH; d++){
+            start[d+1] = start[d] + hist[d];
+            pos[d] = start[d];
+        }
+
+        for(i = 0; i < CUBE_CASES; i++)
+            idx[pos[depth[i]]++] = i;
+    }
+
+    //deallocate
+    Depths::~Depths(){
+        delete[] idx;
+    }
+
+    //cubes of a depth
+    uint32_t Depths::size(int8_t depth) const{
+        return start[depth+1] - start[depth];
+    }
+
+    //cubes from a depth
+    uint32_t Depths::sizeFrom(int8_t depth) const{
+        return CUBE_CASES - start[depth];
+    }
+
+    //get a cube
+    uint32_t Depths::get(int8_t depth, uint32_t i) const{
+        return idx[start[depth] + i];
+    }
+}
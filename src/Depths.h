@@ -0,0 +1,79 @@
+/**
+ * This file contains the class Depths.
+ * It groups the indexes of all the cubes by the number
+ * of moves to solve them, so a cube with a particular
+ * number of moves can be found without searching.
+ */
+
+#ifndef SOLVER2X2_CXX_DEPTHS_H
+#define SOLVER2X2_CXX_DEPTHS_H
+
+#include "Backend.h"
+
+namespace Solver2x2{
+
+    /**
+     * Class Depths
+     * The indexes of the cubes ordered by depth, like the
+     * DEPTH_SIZE array. 14 MB (7!×3^6×4÷1024÷1024).
+     */
+    class Depths{
+    private:
+
+        ///the indexes of the cubes, ordered by depth
+        uint32_t* idx;
+
+        ///the first index of every depth, the last one is the end
+        uint32_t start[MAX_DEPTH+1]{};
+
+    public:
+
+        /**
+         * Group the cubes by depth, with a counting sort.
+         *
+         * @param scramble  : The solutions of the cubes.
+         */
+        explicit Depths(const Explore::Scramble* scramble);
+
+        /**
+         * Group the cubes by depth, the depths are read
+         * from the table in a single batch.
+         *
+         * @param backend   : The table of the cubes.
+         */
+        explicit Depths(TableBackend* backend);
+
+        /**
+         * Deallocate the indexes.
+         */
+        ~Depths();
+
+        /**
+         * Get the number of cubes of a depth.
+         *
+         * @param depth     : The number of moves.
+         * @return          : The number of cubes.
+         */
+        uint32_t size(int8_t depth) const;
+
+        /**
+         * Get the number of cubes from a depth to the max depth.
+         *
+         * @param depth     : The min number of moves.
+         * @return          : The number of cubes.
+         */
+        uint32_t sizeFrom(int8_t depth) const;
+
+        /**
+         * Get a cube of a depth.
+         *
+         * @param depth     : The number of moves.
+         * @param i         : The position of the cube in the depth,
+         *                    it can go over the depth to the next ones.
+         * @return          : The index of the cube.
+         */
+        uint32_t get(int8_t depth, uint32_t i) const;
+    };
+}
+
+#endif //SOLVER2X2_CXX_DEPTHS_H
@@ -0,0 +1,158 @@
+/**
+ * This file contains the class Epoch.
+ * It lets the solves read a table while another thread replaces it.
+ */
+
+#include <thread>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cassert>
+#include "Epoch.h"
+
+namespace Solver2x2{
+
+    //the numbers of the Epochs
+    static std::atomic<uint32_t> epochs{0};
+
+    //the slots of a thread, free when the thread ends
+    struct ThreadSlots{
+        const Epoch* owner[EPOCH_CACHE] = {};
+        Epoch::Slot* slot[EPOCH_CACHE] = {};
+
+        ~ThreadSlots(){
+            for(Epoch::Slot* s : slot)
+                if(s != nullptr)
+                    s->used.store(false, std::memory_order_release);
+        }
+    };
+
+    static thread_local ThreadSlots threadSlots;
+
+    //give the number
+    Epoch::Epoch() : id(epochs.fetch_add(1, std::memory_order_relaxed) % EPOCH_CACHE){}
+
+    //start a read, only the first one of the thread announces the epoch
+    Epoch::Guard::Guard(Epoch& epoch) : slot(epoch.slot(single)){
+        if(slot->nested++ == 0)
+            slot->epoch.store(epoch.current.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    }
+
+    //end a read
+    Epoch::Guard::~Guard(){
+        if(--slot->nested == 0){
+            slot->epoch.store(0, std::memory_order_release);
+
+            if(single)
+                slot->used.store(false, std::memory_order_release);
+        }
+    }
+
+    //a free slot or a new one
+    Epoch::Slot* Epoch::take(){
+        Slot* s;
+        bool used;
+
+        for(s = slots.load(std::memory_order_acquire); s != nullptr; s = s->next){
+            used = false;
+
+            if(s->used.compare_exchange_strong(used, true, std::memory_order_acquire))
+                return s;
+        }
+
+        //a new slot in front of the list
+        s = new Slot();
+        s->next = slots.load(std::memory_order_relaxed);
+
+        while(!slots.compare_exchange_weak(s->next, s, std::memory_order_release, std::memory_order_relaxed));
+
+        return s;
+    }
+
+    //slot of the thread, the one kept or a new one
+    Epoch::Slot* Epoch::slot(bool& single){
+        single = false;
+
+        if(threadSlots.owner[id] == this)
+            return threadSlots.slot[id];
+
+        //the slot kept is read by another Epoch with the same number
+        if(threadSlots.slot[id] != nullptr && threadSlots.slot[id]->nested != 0){
+            single = true;
+            return take();
+        }
+
+        if(threadSlots.slot[id] != nullptr)
+            threadSlots.slot[id]->used.store(false, std::memory_order_release);
+
+        threadSlots.owner[id] = this;
+        threadSlots.slot[id] = take();
+
+        return threadSlots.slot[id];
+    }
+
+    //deallocate the slots
+    Epoch::~Epoch(){
+        Slot* s = slots.load();
+        Slot* next;
+
+        if(threadSlots.owner[id] == this){
+            threadSlots.owner[id] = nullptr;
+            threadSlots.slot[id] = nullptr;
+        }
+
+        while(s != nullptr){
+            next = s->next;
+            delete s;
+            s = next;
+        }
+    }
+
+    //wait the readers of the old epochs
+    void Epoch::synchronize(){
+        uint64_t epoch = current.fetch_add(1, std::memory_order_seq_cst) + 1;
+        uint64_t seen;
+        Slot* s;
+
+        for(s = slots.load(std::memory_order_acquire); s != nullptr; s = s->next){
+            for(;;){
+                seen = s->epoch.load(std::memory_order_seq_cst);
+
+                if(seen == 0 || seen >= epoch)
+                    break;
+
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    //every read in progress is waited, also with the same number
+    void Epoch::test(){
+        std::vector<std::unique_ptr<Epoch>> epochs;
+        std::vector<std::unique_ptr<Guard>> guards;
+        std::atomic<uint32_t> synchronized{0};
+        std::thread writer;
+        uint32_t i;
+
+        for(i = 0; i <= EPOCH_CACHE; i++){
+            epochs.emplace_back(new Epoch());
+            guards.emplace_back(new Guard(*epochs.back()));
+        }
+
+        writer = std::thread([&]{
+            for(std::unique_ptr<Epoch>& epoch : epochs){
+                epoch->synchronize();
+                synchronized++;
+            }
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        assert(synchronized == 0);
+
+        while(!guards.empty())
+            guards.pop_back();
+
+        writer.join();
+        assert(synchronized == EPOCH_CACHE + 1);
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * This file contains the class Epoch.
+ * It lets the solves read a table while another thread replaces it:
+ * the new table is published with an atomic store and the old one is
+ * deallocated only when all the solves that could read it are ended.
+ *
+ * Every thread has a slot with the epoch seen when it started to read,
+ * 0 if it is not reading. The writer moves the epoch forward after the
+ * store and waits the slots with an older epoch. The readers take no
+ * locks, the first read of a thread only takes a free slot.
+ *
+ * A thread keeps its slot of every Epoch, up to EPOCH_CACHE of them,
+ * so the reads of different objects never look for a slot again.
+ */
+
+#ifndef SOLVER2X2_CXX_EPOCH_H
+#define SOLVER2X2_CXX_EPOCH_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * The Epochs whose slot is kept by every thread.
+ */
+#define EPOCH_CACHE 8
+
+namespace Solver2x2{
+
+    /**
+     * Class Epoch
+     * The readers and the epoch of a shared object.
+     */
+    class Epoch{
+    public:
+
+        /**
+         * The reader slot of a thread.
+         */
+        struct Slot{
+            ///the epoch seen by the reader, 0 if it is not reading
+            std::atomic<uint64_t> epoch{0};
+
+            ///true if a thread has the slot
+            std::atomic<bool> used{true};
+
+            ///the reads started and not ended, only the thread changes it
+            uint32_t nested = 0;
+
+            ///the next slot
+            Slot* next = nullptr;
+        };
+
+        /**
+         * Class Guard
+         * A read, from the constructor to the destructor.
+         */
+        class Guard{
+        private:
+
+            ///true if the slot is not kept by the thread, it is freed at the end
+            bool single = false;
+
+            ///the slot of the thread
+            Slot* slot;
+
+        public:
+
+            /**
+             * Start a read.
+             *
+             * @param epoch     : The epoch of the object read.
+             */
+            explicit Guard(Epoch& epoch);
+
+            /**
+             * End the read.
+             */
+            ~Guard();
+
+            Guard(const Guard&) = delete;
+            Guard& operator=(const Guard&) = delete;
+        };
+
+    private:
+
+        ///the number of the Epoch, the position of its slot in the threads
+        const uint32_t id;
+
+        ///the current epoch, from 1
+        std::atomic<uint64_t> current{1};
+
+        ///the slots, never deallocated until the end
+        std::atomic<Slot*> slots{nullptr};
+
+        /**
+         * Take a free slot or a new one.
+         *
+         * @return          : The slot.
+         */
+        Slot* take();
+
+        /**
+         * Get the slot of the calling thread, it is taken at the first read.
+         *
+         * @param single    : Set true if the slot is not kept, it is used by a read
+         *                    while the thread reads another Epoch with the same position.
+         * @return          : The slot.
+         */
+        Slot* slot(bool& single);
+
+    public:
+
+        /**
+         * Give the number to the Epoch.
+         */
+        Epoch();
+
+        /**
+         * Deallocate the slots.
+         */
+        ~Epoch();
+
+        /**
+         * Wait the end of the reads started before the call. After a new
+         * object is published, the old one can be deallocated.
+         */
+        void synchronize();
+
+        /**
+         * Test the reads of more Epochs than the slots kept.
+         */
+        static void test();
+    };
+}
+
+#endif //SOLVER2X2_CXX_EPOCH_H
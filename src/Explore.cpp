@@ -6,10 +6,15 @@
  */
 
 #include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <array>
 #include <memory>
 #include <cstring>
-#include <cassert>
+#include <chrono>
 #include "Explore.h"
+#include "Simd.h"
 
 namespace Solver2x2{
 
@@ -19,18 +24,14 @@ namespace Solver2x2{
     //allocate tree and explored
     Explore::Tree::Tree(){
         uint16_t i;
-        int32_t j;
 
         //allocate 1 array that will be split into a matrix
         cubeArray = new CubeNode[CUBE_CASES];
         exploredArray = new bool[CUBE_CASES];
+        frontier = new uint64_t[(CUBE_CASES+63)/64];
 
-        //split to matrix
-        j = 0;
-        for(i = 0; i < MAX_DEPTH; i++){
-            t[i] = &cubeArray[j];
-            j+=DEPTH_SIZE[i];
-        }
+        //the next depths are split by the generation
+        t[0] = cubeArray;
 
         for(i = 0; i < ORI_CASES; i++)
             explored[i] = &exploredArray[i*PERM_CASES];
@@ -44,6 +45,7 @@ namespace Solver2x2{
     Explore::Tree::~Tree(){
         delete[] cubeArray;
         delete[] exploredArray;
+        delete[] frontier;
     }
 
     //allocate scramble
@@ -70,15 +72,231 @@ namespace Solver2x2{
         return newS;
     }
 
+    //read scramble from file
+    bool Explore::Scramble::read(const std::string& name){
+        std::ifstream file(name, std::ios::binary);
+
+        if(!file)
+            return false;
+
+        file.read(reinterpret_cast<char *>(scrambleArray), sizeof(uint64_t) * CUBE_CASES);
+
+        return (bool)file;
+    }
+
+    //write scramble into file
+    bool Explore::Scramble::write(const std::string& name) const{
+        std::ofstream file(name, std::ios::binary);
+
+        if(!file)
+            return false;
+
+        file.write(reinterpret_cast<const char *>(scrambleArray), sizeof(uint64_t) * CUBE_CASES);
+
+        return (bool)file;
+    }
+
     //get the solve scramble
     uint64_t Explore::Scramble::solve(uint16_t ori, uint16_t perm){
         return s[ori][perm];
     }
 
+    //solve a batch of cubes
+    void Explore::Scramble::solve(const uint32_t idx[], uint64_t res[], uint32_t n) const{
+        uint32_t i;
+
+        for(i = 0; i < n; i++){
+#if defined(__GNUC__)
+            if(i + PREFETCH_DISTANCE < n)
+                __builtin_prefetch(&scrambleArray[idx[i + PREFETCH_DISTANCE]]);
+#endif
+            res[i] = scrambleArray[idx[i]];
+        }
+    }
+
+    //coordinates to index
+    uint32_t Explore::Scramble::index(uint16_t ori, uint16_t perm){
+        return (uint32_t)ori*PERM_CASES + perm;
+    }
+
+    //radix sort of the indexes
+    void Explore::Scramble::sort(uint32_t idx[], uint32_t pos[], uint32_t n){
+        const uint32_t buckets = 1 << RADIX_BITS;
+        std::vector<uint32_t> tmpIdx(n), tmpPos(n), count(buckets);
+        uint32_t* srcIdx = idx, *srcPos = pos, *dstIdx = tmpIdx.data(), *dstPos = tmpPos.data();
+        uint32_t i, b, sum, shift;
+
+        for(shift = 0; shift < 2*RADIX_BITS; shift += RADIX_BITS){
+            std::fill(count.begin(), count.end(), 0);
+
+            for(i = 0; i < n; i++)
+                count[(srcIdx[i] >> shift) & (buckets-1)]++;
+
+            sum = 0;
+            for(b = 0; b < buckets; b++){
+                sum += count[b];
+                count[b] = sum - count[b];
+            }
+
+            for(i = 0; i < n; i++){
+                b = count[(srcIdx[i] >> shift) & (buckets-1)]++;
+                dstIdx[b] = srcIdx[i];
+                dstPos[b] = srcPos[i];
+            }
+
+            std::swap(srcIdx, dstIdx);
+            std::swap(srcPos, dstPos);
+        }
+    }
+
+    //depth of a scramble
+    int8_t Explore::Scramble::depth(uint64_t scramble){
+        return (int8_t)(scramble & 0xF);
+    }
+
+#ifdef SIMD_X86
+    //bits of a depth counter in the packed histogram
+    static const int8_t HIST_BITS = 5;
+
+    //vectors accumulated before a counter overflows
+    static const int8_t HIST_FLUSH = (1 << HIST_BITS) - 1;
+
+    //add the packed counters to the histogram
+    __attribute__((target("avx2")))
+    static void flushHistogram(__m256i& acc, uint32_t hist[]){
+        uint64_t lanes[4];
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+
+        for(int8_t l = 0; l < 4; l++)
+            for(int8_t d = 0; d < MAX_DEPTH; d++)
+                hist[d] += (lanes[l] >> (d*HIST_BITS)) & HIST_FLUSH;
+
+        acc = _mm256_setzero_si256();
+    }
+
+    //count 4 scrambles in the packed counters
+    __attribute__((target("avx2")))
+    static inline __m256i countHistogram(__m256i acc, __m256i scrambles){
+        const __m256i mask = _mm256_set1_epi64x(0xF);
+        const __m256i one = _mm256_set1_epi64x(1);
+        __m256i d;
+
+        d = _mm256_and_si256(scrambles, mask);
+        d = _mm256_add_epi64(_mm256_slli_epi64(d, 2), d);
+
+        return _mm256_add_epi64(acc, _mm256_sllv_epi64(one, d));
+    }
+
+    //histogram of the whole array
+    __attribute__((target("avx2")))
+    static void histogramAvx2(const uint64_t s[], uint32_t n, uint32_t hist[]){
+        __m256i acc = _mm256_setzero_si256();
+        uint32_t i;
+        int8_t count = 0;
+
+        for(i = 0; i+4 <= n; i+=4){
+            acc = countHistogram(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&s[i])));
+
+            if(++count == HIST_FLUSH){
+                flushHistogram(acc, hist);
+                count = 0;
+            }
+        }
+
+        flushHistogram(acc, hist);
+
+        for(; i < n; i++)
+            hist[s[i] & 0xF]++;
+    }
+
+    //depths of a batch
+    __attribute__((target("avx2")))
+    static void depthAvx2(const uint64_t s[], const uint32_t idx[], int8_t res[], uint32_t n){
+        const __m256i mask = _mm256_set1_epi64x(0xF);
+        const __m256i pack = _mm256_setr_epi8(0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                              0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        __m256i d;
+        __m128i vIdx;
+        uint32_t i;
+        int32_t lo, hi;
+
+        for(i = 0; i+4 <= n; i+=4){
+            vIdx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&idx[i]));
+            d = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(s), vIdx, 8);
+            d = _mm256_shuffle_epi8(_mm256_and_si256(d, mask), pack);
+
+            lo = _mm256_extract_epi16(d, 0);
+            hi = _mm256_extract_epi16(d, 8);
+            res[i] = (int8_t)lo;
+            res[i+1] = (int8_t)(lo >> 8);
+            res[i+2] = (int8_t)hi;
+            res[i+3] = (int8_t)(hi >> 8);
+        }
+
+        for(; i < n; i++)
+            res[i] = (int8_t)(s[idx[i]] & 0xF);
+    }
+#endif
+
+    //depths of a batch
+    void Explore::Scramble::depth(const uint32_t idx[], int8_t res[], uint32_t n) const{
+        uint32_t i;
+
+#ifdef SIMD_X86
+        if(hasAvx2()){
+            depthAvx2(scrambleArray, idx, res, n);
+            return;
+        }
+#endif
+
+        for(i = 0; i < n; i++)
+            res[i] = depth(scrambleArray[idx[i]]);
+    }
+
+    //histogram of the whole array
+    void Explore::Scramble::histogram(uint32_t hist[MAX_DEPTH]) const{
+        uint32_t i;
+
+        std::fill(hist, hist+MAX_DEPTH, 0);
+
+#ifdef SIMD_X86
+        if(hasAvx2()){
+            histogramAvx2(scrambleArray, CUBE_CASES, hist);
+            return;
+        }
+#endif
+
+        for(i = 0; i < CUBE_CASES; i++)
+            hist[depth(scrambleArray[i])]++;
+    }
+
     //set first cube already explored
     Explore::Explore(const Coords &coords, Scramble* _scramble) : scramble(_scramble){
         this->coords = coords;
         isExplored(0, 0);
+        sizes[0] = 1;
+    }
+
+    //set the goal cubes already explored, they need no moves
+    Explore::Explore(const Coords &coords, Scramble* _scramble, const std::vector<uint32_t>& goals) :
+            scramble(_scramble), fromGoals(true){
+        uint16_t o, p;
+
+        this->coords = coords;
+
+        for(uint32_t goal : goals){
+            o = (uint16_t)(goal/PERM_CASES);
+            p = (uint16_t)(goal%PERM_CASES);
+
+            if(goal >= CUBE_CASES || isExplored(o, p))
+                continue;
+
+            tree.t[0][sizes[0]].o = o;
+            tree.t[0][sizes[0]].p = p;
+            scramble->s[o][p] = 0;
+            sizes[0]++;
+        }
     }
 
     //set the coordinates
@@ -87,9 +305,52 @@ namespace Solver2x2{
     }
 
     //generate the whole tree
-    void Explore::generate(){
-        for(int8_t i = 0; i < MAX_DEPTH-1; i++)
-            assert(expand(i) == DEPTH_SIZE[i+1]);
+    bool Explore::generate(GenerationReport* report){
+        std::chrono::steady_clock::time_point start, end;
+        int32_t explored = sizes[0], found;
+        bool bottomUp;
+
+        if(report != nullptr){
+            *report = GenerationReport();
+            report->found[0] = (uint32_t)sizes[0];
+            report->treeBytes = sizeof(CubeNode)*CUBE_CASES + sizeof(bool)*CUBE_CASES
+                    + sizeof(uint64_t)*((CUBE_CASES+63)/64);
+            report->scrambleBytes = sizeof(uint64_t)*CUBE_CASES;
+        }
+
+        for(int8_t i = 0; i < MAX_DEPTH-1 && explored < CUBE_CASES; i++){
+            tree.t[i+1] = tree.t[i] + sizes[i];
+            bottomUp = sizes[i] > (CUBE_CASES-explored)/BOTTOM_UP_ALPHA;
+            start = std::chrono::steady_clock::now();
+            found = bottomUp ? expandBottomUp(i) : expand(i);
+            end = std::chrono::steady_clock::now();
+
+            //the bottom up checks the parents of the not explored cubes, the expand the sons of the frontier
+            if(report != nullptr){
+                report->seconds[i+1] = std::chrono::duration<double>(end - start).count();
+                report->probes[i+1] = bottomUp ? bottomUpProbes : (uint64_t)sizes[i]*N_MOVES;
+                report->hits[i+1] = bottomUp ? (uint64_t)found : report->probes[i+1] - found;
+                report->found[i+1] = (uint32_t)found;
+                report->bottomUp[i+1] = bottomUp;
+                report->total += report->seconds[i+1];
+            }
+
+            if(!fromGoals && found != DEPTH_SIZE[i+1])
+                return false;
+
+            sizes[i+1] = found;
+            explored += found;
+        }
+
+        if(explored != CUBE_CASES)
+            return false;
+
+        if(report != nullptr){
+            report->estimatedPeakBytes = report->treeBytes + report->scrambleBytes + tempBytes;
+            report->valid = true;
+        }
+
+        return true;
     }
 
     //reallocate tree and explored
@@ -150,7 +411,7 @@ namespace Solver2x2{
 
         idx = 0;
 
-        for(int32_t i = 0; i < DEPTH_SIZE[depth]; i++){
+        for(int32_t i = 0; i < sizes[depth]; i++){
             node = &tree.t[depth][i];
             o = node->o;
             p = node->p;
@@ -175,6 +436,66 @@ namespace Solver2x2{
         return idx;
     }
 
+    //compute sons of a particular depth from the not explored cubes
+    int32_t Explore::expandBottomUp(int8_t depth){
+        auto newDepth = (int8_t)(1+depth);
+        std::vector<std::array<uint32_t, N_MOVES>> oriParent(ORI_CASES);
+        std::vector<std::array<uint16_t, N_MOVES>> permParent(PERM_CASES);
+        uint16_t o, p;
+        uint32_t y;
+        int32_t i, n;
+        int8_t move;
+        uint64_t probes = 0;
+
+        //mark the frontier
+        memset(tree.frontier, 0, sizeof(uint64_t)*((CUBE_CASES+63)/64));
+
+        for(i = 0; i < sizes[depth]; i++){
+            y = Scramble::index(tree.t[depth][i].o, tree.t[depth][i].p);
+            tree.frontier[y >> 6] |= (uint64_t)1 << (y & 63);
+        }
+
+        //the parents of every coordinate
+        for(move = 0; move < N_MOVES; move++){
+            for(o = 0; o < ORI_CASES; o++)
+                oriParent[o][move] = (uint32_t)coords.moveCOri(o, invMove(move))*PERM_CASES;
+
+            for(p = 0; p < PERM_CASES; p++)
+                permParent[p][move] = coords.moveCPerm(p, invMove(move));
+        }
+
+        tempBytes = std::max(tempBytes, sizeof(oriParent[0])*oriParent.capacity() + sizeof(permParent[0])*permParent.capacity());
+        n = 0;
+
+        //the first parent in the frontier, the sons are in index order
+        for(o = 0; o < ORI_CASES; o++){
+            for(p = 0; p < PERM_CASES; p++){
+                if(tree.explored[o][p])
+                    continue;
+
+                for(move = 0; move < N_MOVES; move++){
+                    y = oriParent[o][move] + permParent[p][move];
+
+                    if(tree.frontier[y >> 6] & ((uint64_t)1 << (y & 63))){
+                        tree.explored[o][p] = true;
+                        tree.t[newDepth][n].o = o;
+                        tree.t[newDepth][n].p = p;
+
+                        scramble->s[o][p] = ((((scramble->scrambleArray[y] >> 4) << 4) + invMove(move)) << 4) + newDepth;
+
+                        n++;
+                        break;
+                    }
+                }
+
+                probes += move < N_MOVES ? move+1 : N_MOVES;
+            }
+        }
+
+        bottomUpProbes = probes;
+        return n;
+    }
+
     //check if its already explored
     bool Explore::isExplored(uint16_t o, uint16_t p){
         return tree.explored[o][p] || !(tree.explored[o][p] = true);
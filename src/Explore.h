@@ -9,6 +9,9 @@
 #define SOLVER2X2_CXX_EXPLORE_H
 
 #include "Coords.h"
+#include "Solver2x2.h"
+#include <string>
+#include <vector>
 
 /**
  * The total cases of the 2x2 cube.
@@ -22,6 +25,27 @@
  */
 #define MAX_DEPTH 12
 
+/**
+ * How many lookups ahead the batch solve prefetches
+ * the scramble array.
+ */
+#define PREFETCH_DISTANCE 16
+
+/**
+ * The bits of the radix sort used in the batch solve.
+ * Two passes cover the 22 bits of a cube index.
+ */
+#define RADIX_BITS 11
+
+/**
+ * The generation switches to the bottom up expansion when
+ * the frontier is bigger than the not explored cubes divided
+ * by this value. With 8 the depths 9, 10 and 11 go bottom up:
+ * the depth 9 takes 175 ms against 260 ms top down, while the
+ * depth 8 is still faster top down (90 ms against 130 ms).
+ */
+#define BOTTOM_UP_ALPHA 8
+
 namespace Solver2x2{
 
     /**
@@ -29,7 +53,7 @@ namespace Solver2x2{
      * Compute all the 2x2 cases.
      */
     class Explore{
-    private:
+    public:
 
         /**
          * These are precomputed empiric values.
@@ -53,6 +77,8 @@ namespace Solver2x2{
                 2644
         };
 
+    private:
+
         /**
          * The node for a cube.
          */
@@ -61,7 +87,7 @@ namespace Solver2x2{
             uint16_t o;
             ///Corner permutation
             uint16_t p;
-            ///Sons idx in the next depth
+            ///Sons idx in the next depth, set only by the top down expansion
             int32_t s[N_MOVES];
         }CubeNode; //40 bytes
 
@@ -72,7 +98,7 @@ namespace Solver2x2{
          * It also contains the explored
          * cubes. Useful during the exploration.
          */
-        class Tree{//144 MB (((1+2+2+4×9)×7!×3^6)÷1024)÷1024
+        class Tree{//159 MB (((1+2+2+4×9+4)×7!×3^6)÷1024)÷1024
         public:
 
             /**
@@ -86,8 +112,8 @@ namespace Solver2x2{
             bool* exploredArray;
 
             /**
-             * The cubes tree matrix. Its an implementation
-             * of DEPTH_SIZE array.
+             * The cubes tree matrix, every depth starts after
+             * the cubes of the previous one.
              */
             CubeNode* t[MAX_DEPTH]{};
 
@@ -96,6 +122,12 @@ namespace Solver2x2{
              */
             bool* explored[ORI_CASES]{};
 
+            /**
+             * The bitset of the cubes in the frontier,
+             * used by the bottom up expansion.
+             */
+            uint64_t* frontier;
+
             /**
              * Allocate the tree and the explored array.
              */
@@ -144,6 +176,22 @@ namespace Solver2x2{
              */
             Scramble* clone() const;
 
+            /**
+             * Read the scrambles from a file.
+             *
+             * @param name      : The name of the file.
+             * @return          : True if the file is read.
+             */
+            bool read(const std::string& name);
+
+            /**
+             * Write the scrambles into a file.
+             *
+             * @param name      : The name of the file.
+             * @return          : True if the file is written.
+             */
+            bool write(const std::string& name) const;
+
             /**
              * Return the solve move.
              *
@@ -152,6 +200,60 @@ namespace Solver2x2{
              * @return          : The algorithm to solve the cube,
              */
             uint64_t solve(uint16_t ori, uint16_t perm);
+
+            /**
+             * Return the solve moves of a batch of cubes.
+             * The scramble array is prefetched some lookups ahead,
+             * so the cache misses of the batch overlap.
+             *
+             * @param idx       : The indexes of the cubes.
+             * @param res       : The array to store the compressed scrambles.
+             * @param n         : The number of cubes.
+             */
+            void solve(const uint32_t idx[], uint64_t res[], uint32_t n) const;
+
+            /**
+             * Convert the coordinates into the index of the scramble array.
+             *
+             * @param ori       : Corner orientation.
+             * @param perm      : Corner permutation.
+             * @return          : The index of the cube.
+             */
+            static uint32_t index(uint16_t ori, uint16_t perm);
+
+            /**
+             * Sort the indexes with a radix sort, so the batch solve
+             * reads the scramble array in order.
+             *
+             * @param idx       : The indexes to sort.
+             * @param pos       : The positions of the indexes, sorted with them.
+             * @param n         : The number of indexes.
+             */
+            static void sort(uint32_t idx[], uint32_t pos[], uint32_t n);
+
+            /**
+             * Get the number of moves of a compressed scramble.
+             *
+             * @param scramble  : Compressed scramble.
+             * @return          : The number of moves.
+             */
+            static int8_t depth(uint64_t scramble);
+
+            /**
+             * Return the number of moves to solve a batch of cubes.
+             *
+             * @param idx       : The indexes of the cubes.
+             * @param res       : The array to store the depths.
+             * @param n         : The number of cubes.
+             */
+            void depth(const uint32_t idx[], int8_t res[], uint32_t n) const;
+
+            /**
+             * Count the cubes of the whole array for every depth.
+             *
+             * @param hist      : The array to store the counts.
+             */
+            void histogram(uint32_t hist[MAX_DEPTH]) const;
         };
 
     public:
@@ -179,6 +281,16 @@ namespace Solver2x2{
          */
         explicit Explore(const Coords& coords, Scramble* _scramble);
 
+        /**
+         * Initialize the algorithm from a set of goal cubes, the
+         * search finds the nearest goal cube of every cube.
+         *
+         * @param coords    : The coords object to use in the exploration.
+         * @param _scramble : The scramble pointer to fill.
+         * @param goals     : The indexes of the goal cubes.
+         */
+        Explore(const Coords& coords, Scramble* _scramble, const std::vector<uint32_t>& goals);
+
         /**
          * Default initializer.
          */
@@ -192,8 +304,13 @@ namespace Solver2x2{
 
         /**
          * Generate the tree. It took around 1 second.
+         * Every depth is checked with DEPTH_SIZE, from the goal
+         * cubes all the cubes must be found.
+         *
+         * @param report    : The report to fill, nullptr for no report.
+         * @return          : True if every depth has the right number of cubes.
          */
-        void generate();
+        bool generate(GenerationReport* report = nullptr);
 
         /**
          * Reallocate the tree and the explored cubes.
@@ -226,6 +343,27 @@ namespace Solver2x2{
 
     private:
 
+        /**
+         * The max memory used by the bottom up expansion.
+         */
+        size_t tempBytes = 0;
+
+        /**
+         * The parents checked in the frontier by the last bottom up expansion.
+         */
+        uint64_t bottomUpProbes = 0;
+
+        /**
+         * The number of cubes found for every depth.
+         */
+        int32_t sizes[MAX_DEPTH]{};
+
+        /**
+         * True if the search starts from goal cubes, not from
+         * the solved one.
+         */
+        bool fromGoals = false;
+
         /**
          * Generate the sons of a particular depth.
          *
@@ -234,6 +372,18 @@ namespace Solver2x2{
          */
         int32_t expand(int8_t depth);
 
+        /**
+         * Generate the sons of a particular depth, searching the parents
+         * of the cubes not explored yet. Its faster than the expand when
+         * the frontier is big. Every cube takes the first parent found in
+         * the frontier, so the parent can differ from the expand but the
+         * scramble is still optimal. The sons are in index order.
+         *
+         * @param depth     : The depth from generate the sons.
+         * @return          : The number of cubes found.
+         */
+        int32_t expandBottomUp(int8_t depth);
+
         /**
          * Check if a cube is already explored by the algorithm.
          *
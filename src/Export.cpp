@@ -0,0 +1,130 @@
+/**
+ * This file contains the class Export.
+ * It writes all the cubes of a range of indexes, with their
+ * solution, in a binary or in a CSV file.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include "Export.h"
+
+namespace Solver2x2{
+
+    //set the solutions
+    Export::Export(const Explore::Scramble* scramble, bool csv) : scramble(scramble), csv(csv){}
+
+    //write the range
+    bool Export::write(const std::string& name, uint32_t begin, uint32_t end, uint32_t threads) const{
+        std::ofstream file;
+        std::vector<std::vector<char>> bufs;
+        std::vector<std::thread> workers;
+        uint64_t i, first;
+        uint32_t t;
+
+        //the file is not truncated for a wrong range
+        if(begin > end || end > CUBE_CASES || threads == 0)
+            return false;
+
+        file.open(name, std::ios::binary);
+
+        if(!file)
+            return false;
+
+        bufs.resize(threads);
+
+        for(i = begin; i < end; i += (uint64_t)threads*EXPORT_BLOCK){
+            workers.clear();
+
+            for(t = 0; t < threads; t++){
+                first = i + (uint64_t)t*EXPORT_BLOCK;
+
+                if(first >= end){
+                    bufs[t].clear();
+                    continue;
+                }
+
+                workers.emplace_back(&Export::format, this, (uint32_t)first, (uint32_t)std::min<uint64_t>(first + EXPORT_BLOCK, end), std::ref(bufs[t]));
+            }
+
+            for(std::thread& worker : workers)
+                worker.join();
+
+            for(t = 0; t < threads; t++)
+                file.write(bufs[t].data(), (std::streamsize)bufs[t].size());
+        }
+
+        file.close();
+
+        return !file.fail();
+    }
+
+    //format the cubes
+    void Export::format(uint32_t begin, uint32_t end, std::vector<char>& buf) const{
+        char* c;
+        uint64_t s;
+        uint32_t i, x;
+        int8_t j, size;
+        char digits[8];
+        const char* move;
+
+        buf.resize((size_t)(end-begin) * (csv ? CSV_SIZE : RECORD_SIZE));
+        c = buf.data();
+
+        for(i = begin; i < end; i++){
+            s = scramble->scrambleArray[i];
+
+            if(!csv){
+                Tiles::toTiles(c, (uint16_t)(i/PERM_CASES), (uint16_t)(i%PERM_CASES));
+                c += N_TILES;
+
+                for(j = 0; j < 8; j++)
+                    *c++ = (char)(s >> (8*j));
+
+                continue;
+            }
+
+            //index
+            x = i;
+            j = 0;
+
+            do{
+                digits[j++] = (char)('0' + x%10);
+                x /= 10;
+            }while(x > 0);
+
+            while(j > 0)
+                *c++ = digits[--j];
+
+            *c++ = ',';
+            Tiles::toTiles(c, (uint16_t)(i/PERM_CASES), (uint16_t)(i%PERM_CASES));
+            c += N_TILES;
+            *c++ = ',';
+
+            //moves
+            size = Explore::Scramble::depth(s);
+
+            if(size >= 10)
+                *c++ = '1';
+
+            *c++ = (char)('0' + size%10);
+            *c++ = ',';
+
+            //solution
+            for(j = 0; j < size; j++){
+                s >>= 4;
+                move = moveToStr((int8_t)(s & 0xF));
+
+                if(j > 0)
+                    *c++ = ' ';
+
+                *c++ = move[0];
+                *c++ = move[1];
+            }
+
+            *c++ = '\n';
+        }
+
+        buf.resize(c - buf.data());
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * This file contains the class Export.
+ * It writes all the cubes of a range of indexes, with their
+ * solution, in a binary or in a CSV file.
+ *
+ * The binary file contains a record of RECORD_SIZE bytes for
+ * every cube: the N_TILES colors of the tiles, followed by the
+ * compressed scramble (8 bytes, little endian). The first 4 bits
+ * of the scramble are the number of moves, then every 4 bits
+ * there is a move (F1 F2 F3 R1 R2 R3 U1 U2 U3).
+ *
+ * The CSV file contains a line for every cube:
+ * index,tiles,moves,solution
+ */
+
+#ifndef SOLVER2X2_CXX_EXPORT_H
+#define SOLVER2X2_CXX_EXPORT_H
+
+#include <string>
+#include <vector>
+#include "Explore.h"
+#include "Tiles.h"
+
+/**
+ * The size of a cube in the binary file.
+ */
+#define RECORD_SIZE (N_TILES + 8)
+
+/**
+ * The max size of a cube in the CSV file.
+ * Index, tiles, moves and the solution, with the separators.
+ */
+#define CSV_SIZE (7 + 1 + N_TILES + 1 + 2 + 1 + 3*(MAX_DEPTH-1) + 1)
+
+/**
+ * The cubes formatted by a thread before writing them.
+ */
+#define EXPORT_BLOCK 65536
+
+namespace Solver2x2{
+
+    /**
+     * Class Export
+     * It formats the cubes in parallel, a block for every
+     * thread, and writes the blocks in order.
+     */
+    class Export{
+    private:
+
+        ///the solutions to export
+        const Explore::Scramble* scramble;
+
+        ///true for the CSV file, false for the binary file
+        bool csv;
+
+    public:
+
+        /**
+         * Set the solutions to export.
+         *
+         * @param scramble  : The solutions.
+         * @param csv       : True for the CSV file, false for the binary file.
+         */
+        Export(const Explore::Scramble* scramble, bool csv);
+
+        /**
+         * Write the cubes of a range of indexes. The same range
+         * gives always the same file.
+         *
+         * @param name      : The name of the file.
+         * @param begin     : The first index.
+         * @param end       : The index after the last one.
+         * @param threads   : The number of threads.
+         * @return          : True if its done correctly, false if not.
+         */
+        bool write(const std::string& name, uint32_t begin, uint32_t end, uint32_t threads) const;
+
+    private:
+
+        /**
+         * Format a range of cubes.
+         *
+         * @param begin     : The first index.
+         * @param end       : The index after the last one.
+         * @param buf       : The buffer where the cubes are formatted.
+         */
+        void format(uint32_t begin, uint32_t end, std::vector<char>& buf) const;
+    };
+}
+
+#endif //SOLVER2X2_CXX_EXPORT_H
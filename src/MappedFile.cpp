@@ -0,0 +1,112 @@
+/**
+ * This file contains the class MappedFile.
+ * It maps a table file in memory read only.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include "MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define HAS_MMAP
+#endif
+
+namespace Solver2x2{
+
+    //unmap the file
+    MappedFile::~MappedFile(){
+        close();
+    }
+
+    //map the whole file
+    bool MappedFile::open(const std::string& name){
+        close();
+
+#ifdef HAS_MMAP
+        struct stat info{};
+        int fd = ::open(name.c_str(), O_RDONLY);
+
+        if(fd < 0)
+            return false;
+
+        if(fstat(fd, &info) != 0 || info.st_size <= 0){
+            ::close(fd);
+            return false;
+        }
+
+        map = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if(map == MAP_FAILED){
+            map = nullptr;
+            return false;
+        }
+
+        data = static_cast<const uint8_t*>(map);
+        length = (size_t)info.st_size;
+#else
+        std::ifstream file(name, std::ios::binary | std::ios::ate);
+
+        if(!file)
+            return false;
+
+        copy.resize((size_t)file.tellg());
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(copy.data()), (std::streamsize)copy.size());
+
+        if(!file || copy.empty()){
+            close();
+            return false;
+        }
+
+        data = copy.data();
+        length = copy.size();
+#endif
+
+        return true;
+    }
+
+    //the new file next to the old one, so the rename does not copy it
+    std::string MappedFile::temporary(const std::string& name){
+        return name + ".tmp";
+    }
+
+    //the old file stays until its last mapping is closed
+    bool MappedFile::replace(const std::string& name, bool written){
+        const std::string temp = temporary(name);
+
+        if(!written){
+            std::remove(temp.c_str());
+            return false;
+        }
+
+#ifndef HAS_MMAP
+        //the file is read, not mapped, and the rename does not replace
+        std::remove(name.c_str());
+#endif
+
+        if(std::rename(temp.c_str(), name.c_str()) != 0){
+            std::remove(temp.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    //unmap the file
+    void MappedFile::close(){
+#ifdef HAS_MMAP
+        if(map != nullptr)
+            munmap(map, length);
+#endif
+
+        map = nullptr;
+        data = nullptr;
+        length = 0;
+        copy = std::vector<uint8_t>();
+    }
+}
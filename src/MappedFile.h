@@ -0,0 +1,102 @@
+/**
+ * This file contains the class MappedFile.
+ * It maps a table file in memory read only, the pages are read
+ * from the disk when they are used and they are shared by the
+ * processes that map the same file. Without mmap the file is read.
+ */
+
+#ifndef SOLVER2X2_CXX_MAPPEDFILE_H
+#define SOLVER2X2_CXX_MAPPEDFILE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace Solver2x2{
+
+    /**
+     * Class MappedFile
+     * The bytes of a file, mapped or read.
+     */
+    class MappedFile{
+    private:
+
+        ///the bytes of the file
+        const uint8_t* data = nullptr;
+
+        ///the size of the file
+        size_t length = 0;
+
+        ///the mapping, nullptr if the file is read
+        void* map = nullptr;
+
+        ///the read file, without mmap
+        std::vector<uint8_t> copy;
+
+    public:
+
+        MappedFile() = default;
+
+        /**
+         * Unmap the file.
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * Map a file, the previous one is unmapped.
+         *
+         * @param name      : The name of the file.
+         * @return          : True if the file is mapped.
+         */
+        bool open(const std::string& name);
+
+        /**
+         * Unmap the file.
+         */
+        void close();
+
+        /**
+         * Get the name of the file written before it replaces a file,
+         * the file can be mapped while it is written.
+         *
+         * @param name      : The name of the file.
+         * @return          : The name of the temporary file.
+         */
+        static std::string temporary(const std::string& name);
+
+        /**
+         * Replace a file with its temporary file, the mappings of
+         * the old file keep its bytes.
+         *
+         * @param name      : The name of the file.
+         * @param written   : True if the temporary file is complete,
+         *                    otherwise it is removed.
+         * @return          : True if the file is replaced.
+         */
+        static bool replace(const std::string& name, bool written);
+
+        /**
+         * Get the bytes of the file.
+         *
+         * @return          : The first byte, nullptr if there is no file.
+         */
+        const uint8_t* bytes() const{
+            return data;
+        }
+
+        /**
+         * Get the size of the file.
+         *
+         * @return          : The bytes of the file.
+         */
+        size_t size() const{
+            return length;
+        }
+    };
+}
+
+#endif //SOLVER2X2_CXX_MAPPEDFILE_H
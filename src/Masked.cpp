@@ -0,0 +1,201 @@
+/**
+ * This file contains the class Masked.
+ * It reads a cube with some unknown tiles and finds
+ * all the cubes that agree with the known tiles.
+ *
+ * The unknown tiles are given with WILDCARD, the others
+ * with the colors of the cube (Y W B G R O) or, like in
+ * Tiles, with the faces (U R F D L B).
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include "Masked.h"
+
+namespace Solver2x2{
+
+    //read the cube, the faces are converted into the colors of the solved cube
+    Masked::Masked(const std::string& cube){
+        int8_t count[N_FACES] = {};
+        const char* color;
+        const char* face;
+        bool faces = false;
+        int8_t i;
+
+        error = NO_ERROR;
+
+        if(cube.length() != N_TILES){
+            error = FEW_TILES;
+            return;
+        }
+
+        for(i = 0; i < N_TILES; i++){
+            this->cube[i] = (char)std::tolower((unsigned char)cube.at(i));
+            faces |= this->cube[i] != '\0' && strchr(FACE_ONLY, this->cube[i]) != nullptr;
+        }
+
+        for(i = 0; i < N_TILES; i++){
+            if(this->cube[i] == WILDCARD)
+                continue;
+
+            if(faces){
+                face = strchr(FACE_COLORS[0], this->cube[i]);
+
+                if(this->cube[i] == '\0' || face == nullptr){
+                    error = ERR_COLOR;
+                    return;
+                }
+
+                this->cube[i] = (char)std::tolower((unsigned char)FACE_COLORS[1][face - FACE_COLORS[0]]);
+            }
+
+            color = strchr(INV_COLOR[0], this->cube[i]);
+
+            if(this->cube[i] == '\0' || color == nullptr || ++count[color-INV_COLOR[0]] > N_TILES_FACE){
+                error = ERR_COLOR;
+                return;
+            }
+        }
+    }
+
+    //eventually error
+    Error Masked::getError() const{
+        return error;
+    }
+
+    //find the cubes
+    void Masked::candidates(std::vector<uint32_t>& idx){
+        const int8_t dbl[C_STATES] = {D_BL, B_DL, L_DB};
+        char colors[N_ROTATIONS][C_STATES];
+        std::vector<bool> seen;
+        int8_t c, r, n, i, found;
+        bool ok;
+
+        idx.clear();
+
+        if(error != NO_ERROR)
+            return;
+
+        //the colors of the DBL corner, like any corner of the solved cube
+        found = 0;
+
+        for(c = 0; c < N_CORNERS; c++){
+            for(r = 0; r < C_STATES; r++){
+                ok = true;
+
+                for(n = 0; n < C_STATES; n++){
+                    colors[found][n] = (char)std::tolower((unsigned char)FACE_COLORS[1][strchr(FACE_COLORS[0], CORNER_FACES[c][(r+n)%C_STATES]) - FACE_COLORS[0]]);
+                    ok &= cube[dbl[n]] == WILDCARD || cube[dbl[n]] == colors[found][n];
+                }
+
+                if(ok)
+                    found++;
+            }
+        }
+
+        //the same cube can be found holding it in different ways
+        if(found > 1)
+            seen.resize(ORI_CASES*PERM_CASES);
+
+        for(i = 0; i < found; i++)
+            if(setOptions(colors[i]))
+                search(0, 1 << DBL, 0, idx, found > 1 ? &seen : nullptr);
+    }
+
+    //find the cubies of every corner
+    bool Masked::setOptions(const char colors[C_STATES]){
+        const char dblFaces[C_STATES+1] = "dbl";
+        const char oppFaces[C_STATES+1] = "ufr";
+        char faces[N_TILES], map[128] = {};
+        int8_t i, c, t, n, k;
+        bool ok;
+
+        //colors to faces
+        for(i = 0; i < C_STATES; i++){
+            map[(int8_t)colors[i]] = dblFaces[i];
+            map[(int8_t)INV_COLOR[1][strchr(INV_COLOR[0], colors[i]) - INV_COLOR[0]]] = oppFaces[i];
+        }
+
+        for(i = 0; i < N_TILES; i++)
+            faces[i] = cube[i] == WILDCARD ? WILDCARD : map[(int8_t)cube[i]];
+
+        k = 0;
+
+        for(i = 0; i < N_CORNERS; i++){
+            options[i].clear();
+
+            if(i == DBL)
+                continue;
+
+            for(c = 0; c < N_CORNERS; c++){
+                if(c == DBL)
+                    continue;
+
+                for(t = 0; t < C_STATES; t++){
+                    ok = true;
+
+                    for(n = 0; n < C_STATES && ok; n++){
+                        ok = faces[C_ORDER[i*C_STATES + (n+t)%C_STATES]] == WILDCARD ||
+                             faces[C_ORDER[i*C_STATES + (n+t)%C_STATES]] == CORNER_FACES[c][n];
+                    }
+
+                    if(ok)
+                        options[i].push_back((int8_t)(c*C_STATES + t));
+                }
+            }
+
+            if(options[i].empty())
+                return false;
+
+            order[k++] = i;
+        }
+
+        //the corners with less options first
+        std::sort(order, order+k, [this](int8_t a, int8_t b){
+            return options[a].size() < options[b].size();
+        });
+
+        ori[DBL] = 0;
+        perm[DBL] = DBL;
+
+        return true;
+    }
+
+    //search the corners
+    void Masked::search(int8_t n, uint8_t used, int8_t twist, std::vector<uint32_t>& idx, std::vector<bool>* seen){
+        int8_t pos, c;
+        uint32_t x;
+
+        if(n == N_CORNERS-1){
+            if(twist%C_STATES != 0)
+                return;
+
+            x = (uint32_t)Coords::comCOri(ori)*PERM_CASES + Coords::compCPerm(perm);
+
+            if(seen != nullptr){
+                if((*seen)[x])
+                    return;
+
+                (*seen)[x] = true;
+            }
+
+            idx.push_back(x);
+            return;
+        }
+
+        pos = order[n];
+
+        for(int8_t opt : options[pos]){
+            c = (int8_t)(opt/C_STATES);
+
+            if(used & (1 << c))
+                continue;
+
+            ori[pos] = (int8_t)(opt%C_STATES);
+            perm[pos] = c;
+
+            search((int8_t)(n+1), (uint8_t)(used | (1 << c)), (int8_t)(twist + ori[pos]), idx, seen);
+        }
+    }
+}
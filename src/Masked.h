@@ -0,0 +1,110 @@
+/**
+ * This file contains the class Masked.
+ * It reads a cube with some unknown tiles and finds
+ * all the cubes that agree with the known tiles.
+ *
+ * The unknown tiles are given with WILDCARD, the others
+ * with the colors of the cube (Y W B G R O) or, like in
+ * Tiles, with the faces (U R F D L B). R and B are both
+ * colors and faces: the cube is read with the faces if
+ * a tile is U, F, D or L, else with the colors.
+ */
+
+#ifndef SOLVER2X2_CXX_MASKED_H
+#define SOLVER2X2_CXX_MASKED_H
+
+#include <string>
+#include <vector>
+#include "Tiles.h"
+
+/**
+ * The char of an unknown tile.
+ */
+#define WILDCARD '?'
+
+/**
+ * The number of ways to hold the cube, the colors
+ * that the DBL corner can have.
+ */
+#define N_ROTATIONS 24
+
+/**
+ * The faces that are not colors, a cube with one of
+ * them is read with the faces.
+ */
+#define FACE_ONLY "ufdl"
+
+namespace Solver2x2{
+
+    /**
+     * Class Masked
+     * It enumerates the coordinates of the cubes that agree
+     * with the known tiles.
+     */
+    class Masked{
+    private:
+
+        ///the cube tiles in lower case
+        char cube[N_TILES];
+
+        ///eventually error
+        Error error;
+
+        ///the cubies that can stay in every corner, with their orientation
+        std::vector<int8_t> options[N_CORNERS];
+
+        ///the positions in the order of the search
+        int8_t order[N_CORNERS-1];
+
+        ///the corners found by the search
+        int8_t ori[N_CORNERS], perm[N_CORNERS];
+
+    public:
+
+        /**
+         * Read the cube.
+         *
+         * @param cube      : The cube string, with WILDCARD for the unknown tiles.
+         */
+        explicit Masked(const std::string& cube);
+
+        /**
+         * Get the eventual error.
+         *
+         * @return      : The error value.
+         */
+        Error getError() const;
+
+        /**
+         * Find the cubes that agree with the known tiles.
+         *
+         * @param idx       : The vector where the indexes of the cubes are stored,
+         *                    without duplicates.
+         */
+        void candidates(std::vector<uint32_t>& idx);
+
+    private:
+
+        /**
+         * Find the cubies that can stay in every corner, holding the
+         * cube with a particular color on the faces of the DBL corner.
+         *
+         * @param colors    : The colors of the D, B and L faces.
+         * @return          : False if no cube agrees, true if not.
+         */
+        bool setOptions(const char colors[C_STATES]);
+
+        /**
+         * Search the corners one at a time.
+         *
+         * @param n         : The number of corners already placed.
+         * @param used      : The cubies already placed.
+         * @param twist     : The sum of the orientations.
+         * @param idx       : The vector of the indexes found.
+         * @param seen      : The cubes already found, used only with more rotations.
+         */
+        void search(int8_t n, uint8_t used, int8_t twist, std::vector<uint32_t>& idx, std::vector<bool>* seen);
+    };
+}
+
+#endif //SOLVER2X2_CXX_MASKED_H
@@ -0,0 +1,113 @@
+/**
+ * This file contains the parser of the standard notation.
+ * It converts a sequence of moves like "R U' F2 D L2 B' x y2"
+ * into the moves of the solver (F, R and U), so it can be
+ * applied directly on the coordinates.
+ * The solver keeps the DBL corner still, so the D, L and B
+ * moves are converted into the opposite moves followed by a
+ * rotation of the whole cube.
+ */
+
+#include <cstring>
+#include "Notation.h"
+
+namespace Solver2x2{
+
+    //the sides in the notation order
+    static const char SIDES[] = "URFDLB";
+
+    //the rotations in the notation order
+    static const char ROTATIONS[] = "xyz";
+
+    //where every side goes with a rotation like x, y and z
+    static const int8_t ROT_SIDE[3][N_SIDES] = {
+            {B_SIDE, R_SIDE, U_SIDE, F_SIDE, L_SIDE, D_SIDE},
+            {U_SIDE, F_SIDE, L_SIDE, D_SIDE, B_SIDE, R_SIDE},
+            {R_SIDE, D_SIDE, F_SIDE, L_SIDE, U_SIDE, B_SIDE}
+    };
+
+    //the rotation along the axis of a side
+    static const int8_t SIDE_AXIS[3] = {1, 0, 2};
+
+    //the first solver move of a side
+    static const int8_t SIDE_MOVE[3] = {U1_MOVE, R1_MOVE, F1_MOVE};
+
+    //start not rotated
+    Notation::Notation(){
+        reset();
+    }
+
+    //reset the rotation
+    void Notation::reset(){
+        for(int8_t i = 0; i < N_SIDES; i++)
+            frame[i] = i;
+    }
+
+    //rotate the cube
+    void Notation::rotate(const int8_t rot[N_SIDES], int8_t turns, bool real){
+        int8_t old[N_SIDES];
+        int8_t i, j;
+
+        //rotating the real cube moves the sides under the frame
+        if(real)
+            turns = (int8_t)((4-turns)%4);
+
+        for(j = 0; j < turns; j++){
+            memcpy(old, frame, N_SIDES);
+
+            for(i = 0; i < N_SIDES; i++)
+                frame[i] = real ? old[rot[i]] : rot[old[i]];
+        }
+    }
+
+    //parse a sequence
+    bool Notation::parse(const std::string& s, std::vector<int8_t>& moves){
+        const char* side, *rot;
+        int8_t turns, f;
+        size_t i, n;
+
+        n = s.size();
+        i = 0;
+
+        while(i < n){
+            if(s[i] == ' ' || s[i] == '\t' || s[i] == '\n' || s[i] == '\r'){
+                i++;
+                continue;
+            }
+
+            side = s[i] != '\0' ? strchr(SIDES, s[i]) : nullptr;
+            rot = s[i] != '\0' ? strchr(ROTATIONS, s[i]) : nullptr;
+
+            if(side == nullptr && rot == nullptr)
+                return false;
+
+            i++;
+            turns = 1;
+
+            if(i < n && s[i] >= '1' && s[i] <= '3')
+                turns = (int8_t)(s[i++]-'0');
+
+            if(i < n && s[i] == '\'' ){
+                turns = (int8_t)(4-turns);
+                i++;
+            }
+
+            if(rot != nullptr){
+                rotate(ROT_SIDE[rot-ROTATIONS], turns, true);
+                continue;
+            }
+
+            f = frame[side-SIDES];
+
+            //the opposite side turns the same way, then the whole cube follows
+            if(f >= 3){
+                f = (int8_t)(f-3);
+                rotate(ROT_SIDE[SIDE_AXIS[f]], turns, false);
+            }
+
+            moves.push_back((int8_t)(SIDE_MOVE[f]+turns-1));
+        }
+
+        return true;
+    }
+}
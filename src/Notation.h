@@ -0,0 +1,88 @@
+/**
+ * This file contains the parser of the standard notation.
+ * It converts a sequence of moves like "R U' F2 D L2 B' x y2"
+ * into the moves of the solver (F, R and U), so it can be
+ * applied directly on the coordinates.
+ * The solver keeps the DBL corner still, so the D, L and B
+ * moves are converted into the opposite moves followed by a
+ * rotation of the whole cube.
+ */
+
+#ifndef SOLVER2X2_CXX_NOTATION_H
+#define SOLVER2X2_CXX_NOTATION_H
+
+#include <string>
+#include <vector>
+#include "move.h"
+
+/**
+ * The number of faces of the cube.
+ */
+#define N_SIDES 6
+
+namespace Solver2x2{
+
+    /**
+     * The faces of the cube. The opposite face is
+     * the face plus 3.
+     */
+    enum Side : int8_t{
+        U_SIDE = 0,
+        R_SIDE = 1,
+        F_SIDE = 2,
+        D_SIDE = 3,
+        L_SIDE = 4,
+        B_SIDE = 5
+    };
+
+    /**
+     * Class Notation
+     * It parses the moves, keeping track of the rotation
+     * of the cube between a call and the next one.
+     */
+    class Notation{
+    private:
+
+        ///the side of the solver cube for every side of the real cube
+        int8_t frame[N_SIDES];
+
+    public:
+
+        /**
+         * Start from the cube not rotated.
+         */
+        Notation();
+
+        /**
+         * Parse a sequence of moves.
+         * It accepts the faces U R F D L B, the rotations x y z,
+         * followed by nothing, ', 2, 2' or the number of quarter turns
+         * used by the solver (1, 2, 3). The moves can be separated
+         * by spaces or not.
+         *
+         * @param s         : The sequence to parse.
+         * @param moves     : The vector where the solver moves are appended.
+         * @return          : True if its done correctly, false if not.
+         */
+        bool parse(const std::string& s, std::vector<int8_t>& moves);
+
+        /**
+         * Reset the rotation of the cube.
+         */
+        void reset();
+
+    private:
+
+        /**
+         * Rotate the whole cube.
+         *
+         * @param rot       : The rotation of the sides.
+         * @param turns     : The number of quarter turns.
+         * @param real      : True to rotate the real cube, false to
+         *                    rotate the solver cube.
+         */
+        void rotate(const int8_t rot[N_SIDES], int8_t turns, bool real);
+    };
+}
+
+#endif //SOLVER2X2_CXX_NOTATION_H
@@ -0,0 +1,66 @@
+/**
+ * This file contains the helpers for the SIMD code.
+ * The SIMD functions are compiled for their instruction set
+ * with the target attribute and chosen at runtime, so the
+ * library needs no special flags and runs on every cpu.
+ */
+
+#ifndef SOLVER2X2_CXX_SIMD_H
+#define SOLVER2X2_CXX_SIMD_H
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Solver2x2{
+
+    /**
+     * Check if the cpu supports SSSE3.
+     *
+     * @return      : True if supported, false if not.
+     */
+    inline bool hasSsse3(){
+#ifdef SIMD_X86
+        static const bool ssse3 = __builtin_cpu_supports("ssse3");
+        return ssse3;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Check if the cpu supports AVX2.
+     *
+     * @return      : True if supported, false if not.
+     */
+    inline bool hasAvx2(){
+#ifdef SIMD_X86
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Check if the cpu supports AVX-512.
+     *
+     * @return      : True if supported, false if not.
+     */
+    inline bool hasAvx512(){
+#ifdef SIMD_X86
+        static const bool avx512 = __builtin_cpu_supports("avx512f");
+        return avx512;
+#else
+        return false;
+#endif
+    }
+}
+
+#endif //SOLVER2X2_CXX_SIMD_H
@@ -16,120 +16,2083 @@
  *  You can give directly the color of the cube.
  */
 
+#include <thread>
+#include <mutex>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
 #include <fstream>
+#include <algorithm>
 #include <cassert>
 #include "Solver2x2.h"
+#include "Solver2x2_c.h"
 #include "Explore.h"
 #include "Coords.h"
 #include "Tiles.h"
+#include "Notation.h"
+#include "Masked.h"
+#include "Export.h"
+#include "Depths.h"
+#include "DepthFile.h"
+#include "Backend.h"
+#include "Epoch.h"
+#include "Async.h"
+#include "CornerDB.h"
+#include "Costs.h"
+#include "Verify.h"
 
 namespace Solver2x2{
-    //explore pointer
-    static Explore::Scramble* scramble = nullptr;
+    /**
+     * A table with all it needs, it is replaced as a whole. The solves
+     * read only the backend and the loader, the depths are built once by
+     * the first reader, the other fields are changed only with the writer lock.
+     */
+    struct Table{
+        //table used by the solve
+        TableBackend* backend = nullptr;
 
-    //init the solver
-    void init(){
-        deinit();
-        scramble = new Explore::Scramble();
+        //the kind of the table
+        Backend type = FULL_BACKEND;
+
+        //explore pointer, nullptr with the small tables until it is needed
+        Explore::Scramble* scramble = nullptr;
+
+        //cubes grouped by depth, built at the first use, shared by the tables with the same depths
+        mutable std::shared_ptr<const Depths> depths;
+
+        //the depths are built by a single reader
+        mutable std::once_flag depthsBuilt;
+
+        //reader of the file ordered by depth, while it is read
+        DepthFile* loader = nullptr;
+
+        ~Table(){
+            delete loader;
+            delete backend;
+            delete scramble;
+        }
+    };
+
+    //the table read by the solves
+    static std::atomic<Table*> table{nullptr};
+
+    //the solves reading the table
+    static Epoch readers;
+
+    //a change of the table at time
+    static std::recursive_mutex writer;
+
+    //the batches of the async solves
+    static std::atomic<Async*> async{nullptr};
+
+    //the solves pushing into the async batches
+    static Epoch asyncReaders;
+
+    //a start or a stop of the async solves at time
+    static std::mutex asyncMutex;
+
+    //true during a stop, the solves do not start the threads again
+    static std::atomic<bool> asyncStopping{false};
+
+    //the corner pattern database
+    static std::atomic<CornerDB*> corners{nullptr};
+
+    //the lookups reading the corner pattern database
+    static Epoch cornerReaders;
+
+    //the goal tables by name, they are replaced all together
+    typedef std::map<std::string, std::shared_ptr<const Explore::Scramble>> GoalTables;
+    static std::atomic<GoalTables*> goalTables{nullptr};
+
+    //the solves reading the goal tables
+    static Epoch goalReaders;
+
+    //coords shared by the sessions
+    static Coords& getCoords(){
+        static Coords coords;
+        return coords;
+    }
+
+    //generate the scrambles, nullptr if a depth has a wrong number of cubes
+    static Explore::Scramble* generate(GenerationReport* report = nullptr){
+        auto* generated = new Explore::Scramble();
+        Coords coords;
+        bool valid;
+
+        {
+            Explore explore(coords, generated);
+            valid = explore.generate(report);
+        }
+
+        if(!valid){
+            delete generated;
+            return nullptr;
+        }
+
+        return generated;
+    }
+
+    //a table that uses the scrambles to solve
+    static Table* fullTable(Explore::Scramble* full){
+        auto* created = new Table();
+
+        created->scramble = full;
+        created->backend = new FullBackend(full);
+
+        return created;
+    }
+
+    //replace the table, the old one is deallocated when no solve reads it
+    static void publish(Table* created){
+        Table* old = table.exchange(created, std::memory_order_seq_cst);
+
+        readers.synchronize();
+        delete old;
+    }
+
+    //create a table of a kind
+    static TableBackend* makeBackend(Backend type, Explore::Scramble* full){
+        switch(type){
+            case DEPTH_BACKEND:
+                return new DepthBackend(getCoords(), full);
+            case MOD3_BACKEND:
+                return new Mod3Backend(getCoords(), full);
+            case MEET_BACKEND:
+                return new MeetBackend(getCoords());
+            case BLOCK_BACKEND:
+                return new BlockBackend(full);
+            default:
+                return new FullBackend(full);
+        }
+    }
+
+    //init the solver, the old table stays if the generation is wrong
+    bool init(){
+        Explore::Scramble* generated = generate();
+
+        if(generated == nullptr)
+            return false;
+
+        Table* created = fullTable(generated);
+        std::lock_guard<std::recursive_mutex> lock(writer);
+
+        publish(created);
+
+        return true;
+    }
+
+    //init the solver with the profile
+    bool init(GenerationReport& report){
+        Explore::Scramble* generated = generate(&report);
+
+        if(generated == nullptr)
+            return false;
+
+        Table* created = fullTable(generated);
+        std::lock_guard<std::recursive_mutex> lock(writer);
+
+        publish(created);
+
+        return true;
+    }
+
+    //report in text
+    std::string reportText(const GenerationReport& report){
+        std::string text;
+        char line[128];
+        int8_t i;
+
+        text = "depth     found        probes     hit rate   ms     mode\n";
+
+        for(i = 0; i < DEPTHS; i++){
+            snprintf(line, sizeof(line), "%5d %9u %13llu %10.2f%% %8.2f %s\n", i, report.found[i],
+                     (unsigned long long)report.probes[i],
+                     report.probes[i] ? 100.0 * (double)report.hits[i] / (double)report.probes[i] : 0.0,
+                     report.seconds[i] * 1000, i == 0 ? "" : report.bottomUp[i] ? "bottom up" : "top down");
+            text += line;
+        }
+
+        snprintf(line, sizeof(line), "total %.2f ms, tree %zu bytes, scramble %zu bytes, estimated peak %zu bytes, %s\n",
+                 report.total * 1000, report.treeBytes, report.scrambleBytes, report.estimatedPeakBytes,
+                 report.valid ? "valid" : "wrong depth count");
+        text += line;
+
+        return text;
+    }
+
+    //deallocate the scramble solver
+    void deinit(){
+        std::lock_guard<std::recursive_mutex> lock(writer);
+
+        publish(nullptr);
+    }
+
+    //get the table to change, the writer lock must be taken, nullptr if it cannot be generated
+    static Table* getWritable(){
+        if(table.load() == nullptr)
+            init();
+
+        return table.load();
+    }
+
+    //get the whole scramble of the table, it waits the reader, nullptr with the small tables
+    static Explore::Scramble* getScramble(){
+        Table* t = getWritable();
+
+        if(t == nullptr)
+            return nullptr;
+
+        if(t->loader != nullptr)
+            t->loader->wait();
+
+        return t->scramble;
+    }
+
+    //get the whole scramble, the small tables generate it only for the caller, that frees it
+    static Explore::Scramble* getScramble(std::unique_ptr<Explore::Scramble>& generated){
+        if(getScramble() != nullptr || getWritable() == nullptr)
+            return getScramble();
+
+        if(generated == nullptr)
+            generated.reset(generate());
+
+        return generated.get();
+    }
+
+    //get the table to read, an Epoch::Guard must be kept while it is used
+    static const Table* getReadable(){
+        return table.load(std::memory_order_seq_cst);
+    }
+
+    //get the backend of a table, it waits the reader
+    static TableBackend* getTable(const Table* t){
+        if(t->loader != nullptr)
+            t->loader->wait();
+
+        return t->backend;
+    }
+
+    //get the solution of a cube, it waits only its depth
+    static uint64_t lookup(const Table* t, uint16_t ori, uint16_t perm){
+        if(t == nullptr)
+            return NOT_LOADED;
+
+        if(t->loader != nullptr)
+            return t->loader->solve(Explore::Scramble::index(ori, perm));
+
+        return t->backend->solve(ori, perm);
+    }
+
+    //get the cubes grouped by depth, an Epoch::Guard must be kept while the table is used
+    static std::shared_ptr<const Depths> getDepths(const Table* t){
+        if(t == nullptr)
+            return nullptr;
+
+        //not at the publish, they are 14 MB for every table and only few callers need them
+        std::call_once(t->depthsBuilt, [t]{
+            std::unique_ptr<Explore::Scramble> generated;
+            std::unique_ptr<TableBackend> full;
+            TableBackend* backend = getTable(t);
+
+            if(std::atomic_load(&t->depths) != nullptr)
+                return;
+
+            //the depths of these tables are searched cube by cube, a generated copy is faster
+            if(t->type == MOD3_BACKEND || t->type == MEET_BACKEND){
+                generated.reset(generate());
+
+                if(generated == nullptr)
+                    return;
+
+                full.reset(makeBackend(FULL_BACKEND, generated.get()));
+                backend = full.get();
+            }
+
+            std::atomic_store(&t->depths, std::shared_ptr<const Depths>(new Depths(backend)));
+        });
+
+        return std::atomic_load(&t->depths);
+    }
+
+    //convert an index into a cube string
+    static std::string toCube(uint32_t idx){
+        char cube[N_TILES];
+
+        Tiles::toTiles(cube, (uint16_t)(idx/PERM_CASES), (uint16_t)(idx%PERM_CASES));
+
+        return std::string(cube, N_TILES);
+    }
+
+    //write to file
+    bool writeFile(const std::string& name){
+        std::unique_ptr<Explore::Scramble> generated;
+        std::lock_guard<std::recursive_mutex> lock(writer);
+
+        return getScramble(generated) != nullptr && getScramble(generated)->write(name);
+    }
+
+    //read the solver from a file, out of the lock
+    bool loadFile(const std::string& name){
+        auto* loaded = new Explore::Scramble();
+        Table* created;
+
+        if(!loaded->read(name)){
+            delete loaded;
+            return writeFile(name);
+        }
+
+        created = fullTable(loaded);
+
+        std::lock_guard<std::recursive_mutex> lock(writer);
+        publish(created);
+
+        return true;
+    }
+
+    //write to file ordered by depth
+    bool writeDepthFile(const std::string& name){
+        std::unique_ptr<Explore::Scramble> generated;
+        std::lock_guard<std::recursive_mutex> lock(writer);
+
+        return getScramble(generated) != nullptr && DepthFile::write(getScramble(generated), name);
+    }
+
+    //read the solver from a file ordered by depth, in background
+    bool loadDepthFile(const std::string& name){
+        auto* loaded = new Explore::Scramble();
+        auto* reader = new DepthFile(loaded);
+        Table* created;
+
+        if(!reader->open(name)){
+            delete reader;
+            delete loaded;
+
+            std::lock_guard<std::recursive_mutex> lock(writer);
+            return init() && writeDepthFile(name);
+        }
+
+        created = fullTable(loaded);
+        created->loader = reader;
+
+        std::lock_guard<std::recursive_mutex> lock(writer);
+        publish(created);
+
+        return true;
+    }
+
+    //depths ready
+    int8_t loadedDepths(){
+        Epoch::Guard guard(readers);
+        const Table* t = getReadable();
+
+        if(t == nullptr)
+            return 0;
+
+        if(t->loader != nullptr)
+            return t->loader->depths();
+
+        return MAX_DEPTH;
+    }
+
+    //file ordered by depth broken
+    bool loadFailed(){
+        Epoch::Guard guard(readers);
+        const Table* t = getReadable();
+
+        return t != nullptr && t->loader != nullptr && t->loader->broken();
+    }
+
+    //costs for the right hand
+    MoveCosts ergonomicCosts(){
+        MoveCosts costs{};
+        int8_t a, b;
+
+        for(a = 0; a < N_MOVES; a++){
+            costs.move[a] = (uint16_t)((a <= F3_MOVE ? 3 : 1) + (a % 3 == 1 ? 1 : 0));
+
+            for(b = 0; b < N_MOVES; b++)
+                costs.pair[a][b] = (uint16_t)((a <= F3_MOVE) != (b <= F3_MOVE) ? 2 : 0);
+        }
+
+        return costs;
+    }
+
+    //choose the solutions with the least cost, on a copy of the table
+    bool setMoveCosts(const MoveCosts& costs, uint32_t threads){
+        std::unique_ptr<Explore::Scramble> generated;
+        std::lock_guard<std::recursive_mutex> lock(writer);
+        Explore::Scramble* chosen;
+
+        //the scramble generated for a small table is changed without a copy
+        if(getScramble(generated) == nullptr)
+            return false;
+
+        chosen = generated != nullptr ? generated.release() : getScramble()->clone();
+
+        if(threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        Costs(chosen, getCoords(), costs).choose(threads);
+        publish(fullTable(chosen));
+
+        return true;
+    }
+
+    //change the table
+    bool setBackend(Backend type){
+        std::unique_ptr<Explore::Scramble> generated;
+        std::lock_guard<std::recursive_mutex> lock(writer);
+        Table* old = getWritable();
+        Explore::Scramble* full = nullptr;
+        Table* created;
+
+        //the hash of MEET_BACKEND is built without the scrambles
+        if(old == nullptr || (type != MEET_BACKEND && (full = getScramble(generated)) == nullptr))
+            return false;
+
+        created = new Table();
+        created->backend = makeBackend(type, full);
+        created->type = type;
+
+        //the full table keeps the scrambles, the small tables free them with the old table or at the end
+        if(type == FULL_BACKEND){
+            created->scramble = generated != nullptr ? generated.release() : old->scramble;
+            old->scramble = nullptr;
+        }
+
+        //the same solutions, the depths are kept if they are built
+        created->depths = std::atomic_load(&old->depths);
+
+        publish(created);
+
+        return true;
+    }
+
+    //kind of the table
+    Backend currentBackend(){
+        Epoch::Guard guard(readers);
+        const Table* t = getReadable();
+
+        return t == nullptr ? FULL_BACKEND : t->type;
+    }
+
+    //write the table
+    bool writeBackend(const std::string& name){
+        std::lock_guard<std::recursive_mutex> lock(writer);
+
+        return getWritable() != nullptr && getTable(getWritable())->write(name);
+    }
+
+    //read the table, out of the lock
+    bool loadBackend(Backend type, const std::string& name){
+        TableBackend* backend;
+        Table* created;
+
+        if(type == FULL_BACKEND)
+            return loadFile(name);
+
+        backend = makeBackend(type, nullptr);
+
+        if(!backend->read(name)){
+            delete backend;
+
+            std::lock_guard<std::recursive_mutex> lock(writer);
+            return init() && setBackend(type) && writeBackend(name);
+        }
+
+        created = new Table();
+        created->backend = backend;
+        created->type = type;
+
+        std::lock_guard<std::recursive_mutex> lock(writer);
+        publish(created);
+
+        return true;
+    }
+
+    //time of the tables
+    std::vector<BackendStats> benchmarkBackends(uint32_t cubes){
+        std::vector<BackendStats> stats;
+        std::vector<uint32_t> idx(cubes);
+        std::mt19937 gen(cubes);
+        std::chrono::steady_clock::time_point start;
+        std::unique_ptr<Explore::Scramble> generated;
+        Explore::Scramble* full;
+        TableBackend* table;
+        uint64_t sum = 0;
+        uint32_t i;
+        int8_t type;
+
+        std::lock_guard<std::recursive_mutex> lock(writer);
+
+        if((full = getScramble(generated)) == nullptr)
+            return stats;
+
+        for(i = 0; i < cubes; i++)
+            idx[i] = std::uniform_int_distribution<uint32_t>(0, CUBE_CASES - 1)(gen);
+
+        for(type = FULL_BACKEND; type <= BLOCK_BACKEND; type++){
+            table = makeBackend((Backend)type, full);
+            start = std::chrono::steady_clock::now();
+
+            for(i = 0; i < cubes; i++)
+                sum += table->solve((uint16_t)(idx[i] / PERM_CASES), (uint16_t)(idx[i] % PERM_CASES));
+
+#if defined(__GNUC__)
+            //the solves are not removed by the compiler
+            __asm__ volatile("" : : "r"(sum) : "memory");
+#endif
+
+            stats.push_back({(Backend)type, table->bytes(),
+                             std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / std::max(cubes, (uint32_t)1)});
+            delete table;
+        }
+
+        return stats;
+    }
+
+    //choose the table
+    Backend adviseBackend(size_t maxBytes, double maxNanos){
+        std::vector<BackendStats> stats = benchmarkBackends();
+        const BackendStats* best = nullptr;
+
+        //the smallest table in the time
+        if(maxNanos > 0)
+            for(const BackendStats& s : stats)
+                if(s.bytes <= maxBytes && s.nanos <= maxNanos && (best == nullptr || s.bytes < best->bytes))
+                    best = &s;
+
+        //the fastest table in the memory
+        if(best == nullptr)
+            for(const BackendStats& s : stats)
+                if(s.bytes <= maxBytes && (best == nullptr || s.nanos < best->nanos))
+                    best = &s;
+
+        //the smallest table
+        if(best == nullptr)
+            for(const BackendStats& s : stats)
+                if(best == nullptr || s.bytes < best->bytes)
+                    best = &s;
+
+        return best == nullptr ? FULL_BACKEND : best->backend;
+    }
+
+    //solve the cube
+    std::string solve(const std::string& cube){
+        Tiles tiles(cube);
+        uint64_t res;
+
+        if(tiles.getError() != NO_ERROR)
+            return "Error";
+
+        Epoch::Guard guard(readers);
+        res = lookup(getReadable(), tiles.getOri(), tiles.getPerm());
+
+        if(res == NOT_LOADED)
+            return "Error";
+
+        return Solver2x2::Explore::convert(res);
+    }
+
+    //solve a cube with unknown tiles
+    std::string solveMasked(const std::string& cube, uint32_t& matched){
+        Masked masked(cube);
+        std::vector<uint32_t> idx;
+        std::vector<int8_t> depths;
+        uint64_t res;
+        size_t best;
+
+        masked.candidates(idx);
+        matched = (uint32_t)idx.size();
+
+        Epoch::Guard guard(readers);
+        const Table* t = getReadable();
+
+        if(idx.empty() || t == nullptr)
+            return "Error";
+
+        depths.resize(idx.size());
+        getTable(t)->depth(idx.data(), depths.data(), matched);
+        best = std::min_element(depths.begin(), depths.end()) - depths.begin();
+
+        res = lookup(t, (uint16_t)(idx[best] / PERM_CASES), (uint16_t)(idx[best] % PERM_CASES));
+
+        if(res == NOT_LOADED)
+            return "Error";
+
+        return Explore::convert(res);
+    }
+
+    //replace a goal table, nullptr to remove it
+    static void publishGoal(const std::string& name, const Explore::Scramble* goal){
+        std::lock_guard<std::recursive_mutex> lock(writer);
+        GoalTables* old = goalTables.load();
+        auto* created = old == nullptr ? new GoalTables() : new GoalTables(*old);
+
+        if(goal == nullptr)
+            created->erase(name);
+        else
+            (*created)[name] = std::shared_ptr<const Explore::Scramble>(goal);
+
+        goalTables.store(created, std::memory_order_seq_cst);
+        goalReaders.synchronize();
+        delete old;
+    }
+
+    //search from all the goals at once
+    static bool makeGoal(const std::string& name, const std::vector<uint32_t>& goals){
+        auto* generated = new Explore::Scramble();
+        bool done;
+
+        {
+            Explore explore(getCoords(), generated, goals);
+            done = !goals.empty() && explore.generate();
+        }
+
+        if(!done){
+            delete generated;
+            return false;
+        }
+
+        publishGoal(name, generated);
+
+        return true;
+    }
+
+    //goal table from cubes and masks
+    bool makeGoal(const std::string& name, const std::vector<std::string>& goals){
+        std::vector<uint32_t> idx, found;
+
+        for(const std::string& goal : goals){
+            Masked masked(goal);
+
+            if(masked.getError() != NO_ERROR)
+                return false;
+
+            masked.candidates(found);
+            idx.insert(idx.end(), found.begin(), found.end());
+        }
+
+        return makeGoal(name, idx);
+    }
+
+    //goal table from a condition
+    bool makeGoal(const std::string& name, const std::function<bool(const std::string&)>& isGoal){
+        std::vector<uint32_t> idx;
+        uint32_t i;
+
+        for(i = 0; i < CUBE_CASES; i++)
+            if(isGoal(toCube(i)))
+                idx.push_back(i);
+
+        return makeGoal(name, idx);
+    }
+
+    //write a goal table
+    bool writeGoal(const std::string& name, const std::string& file){
+        Epoch::Guard guard(goalReaders);
+        const GoalTables* goals = goalTables.load(std::memory_order_seq_cst);
+        GoalTables::const_iterator it;
+
+        if(goals == nullptr || (it = goals->find(name)) == goals->end())
+            return false;
+
+        return it->second->write(file);
+    }
+
+    //read a goal table
+    bool loadGoal(const std::string& name, const std::string& file){
+        auto* loaded = new Explore::Scramble();
+
+        if(!loaded->read(file)){
+            delete loaded;
+            return false;
+        }
+
+        publishGoal(name, loaded);
+
+        return true;
+    }
+
+    //remove a goal table
+    void removeGoal(const std::string& name){
+        publishGoal(name, nullptr);
+    }
+
+    //names of the goal tables
+    std::vector<std::string> goalNames(){
+        Epoch::Guard guard(goalReaders);
+        const GoalTables* goals = goalTables.load(std::memory_order_seq_cst);
+        std::vector<std::string> names;
+
+        if(goals != nullptr)
+            for(const auto& goal : *goals)
+                names.push_back(goal.first);
+
+        return names;
+    }
+
+    //solve to a goal
+    std::string solveGoal(const std::string& cube, const std::string& goal){
+        std::string reached;
+
+        return solveGoal(cube, std::vector<std::string>{goal}, reached);
+    }
+
+    //solve to the nearest goal of the tables
+    std::string solveGoal(const std::string& cube, const std::vector<std::string>& goals, std::string& reached){
+        Tiles tiles(cube);
+        const Explore::Scramble* best = nullptr;
+        GoalTables::const_iterator it;
+        uint32_t idx;
+
+        reached = "";
+
+        if(tiles.getError() != NO_ERROR)
+            return "Error";
+
+        Epoch::Guard guard(goalReaders);
+        const GoalTables* tables = goalTables.load(std::memory_order_seq_cst);
+
+        if(tables == nullptr)
+            return "Error";
+
+        idx = Explore::Scramble::index(tiles.getOri(), tiles.getPerm());
+
+        //the first table on a tie
+        for(it = tables->begin(); it != tables->end(); it++){
+            if(!goals.empty() && std::find(goals.begin(), goals.end(), it->first) == goals.end())
+                continue;
+
+            if(best == nullptr || Explore::Scramble::depth(it->second->scrambleArray[idx]) <
+                                  Explore::Scramble::depth(best->scrambleArray[idx])){
+                best = it->second.get();
+                reached = it->first;
+            }
+        }
+
+        if(best == nullptr)
+            return "Error";
+
+        return Explore::convert(best->scrambleArray[idx]);
+    }
+
+    //solve from a cube to another one
+    std::string solveTo(const std::string& from, const std::string& to){
+        Tiles a(from), b(to);
+        uint64_t res;
+        uint16_t ori, perm;
+
+        if(a.getError() != NO_ERROR || b.getError() != NO_ERROR)
+            return "Error";
+
+        //the scramble that solves b^-1·a changes a into b
+        Coords::inverse(b.getOri(), b.getPerm(), ori, perm);
+        Coords::compose(ori, perm, a.getOri(), a.getPerm(), ori, perm);
+
+        Epoch::Guard guard(readers);
+        res = lookup(getReadable(), ori, perm);
+
+        if(res == NOT_LOADED)
+            return "Error";
+
+        return Explore::convert(res);
+    }
+
+    //convert the valid cubes into indexes
+    static void toIndex(const std::vector<std::string>& cubes, std::vector<uint32_t>& idx, std::vector<uint32_t>& pos){
+        uint32_t i;
+
+        idx.reserve(cubes.size());
+        pos.reserve(cubes.size());
+
+        for(i = 0; i < cubes.size(); i++){
+            Tiles tiles(cubes[i]);
+
+            if(tiles.getError() != NO_ERROR)
+                continue;
+
+            idx.push_back(Explore::Scramble::index(tiles.getOri(), tiles.getPerm()));
+            pos.push_back(i);
+        }
+    }
+
+    //solve the indexes of a batch, res has "Error" for the other cubes
+    static void solveBatch(std::vector<uint32_t>& idx, std::vector<uint32_t>& pos, std::vector<std::string>& res, bool sorted){
+        std::vector<uint64_t> moves;
+        uint32_t i, n = (uint32_t)idx.size();
+
+        if(sorted)
+            Explore::Scramble::sort(idx.data(), pos.data(), n);
+
+        Epoch::Guard guard(readers);
+        const Table* t = getReadable();
+
+        if(t == nullptr)
+            return;
+
+        //gather the scrambles
+        moves.resize(n);
+        getTable(t)->solve(idx.data(), moves.data(), n);
+
+        for(i = 0; i < n; i++)
+            res[pos[i]] = Explore::convert(moves[i]);
+    }
+
+    //solve a batch of cubes
+    std::vector<std::string> solve(const std::vector<std::string>& cubes, bool sorted){
+        std::vector<std::string> res(cubes.size(), "Error");
+        std::vector<uint32_t> idx, pos;
+
+        toIndex(cubes, idx, pos);
+        solveBatch(idx, pos, res, sorted);
+
+        return res;
+    }
+
+    //pack the colors of the cubes
+    uint32_t packCubes(const std::vector<std::string>& cubes, uint8_t packed[]){
+        int8_t faces[N_TILES];
+        uint32_t i, valid = 0;
+
+        for(i = 0; i < cubes.size(); i++){
+            if(cubes[i].length() == N_TILES && Tiles::toFaces(cubes[i].data(), faces)){
+                Tiles::pack(faces, packed + (size_t)i*PACKED_BYTES);
+                valid++;
+            }else
+                memset(packed + (size_t)i*PACKED_BYTES, 0xFF, PACKED_BYTES);
+        }
+
+        return valid;
+    }
+
+    //unpack the cubes with the colors of the solved cube
+    std::vector<std::string> unpackCubes(const uint8_t packed[], size_t n){
+        std::vector<std::string> cubes(n, "Error");
+        int8_t faces[N_TILES];
+        char cube[N_TILES];
+        size_t i;
+
+        for(i = 0; i < n; i++){
+            if(!Tiles::unpack(packed + i*PACKED_BYTES, faces))
+                continue;
+
+            Tiles::toColors(faces, cube);
+            cubes[i].assign(cube, N_TILES);
+        }
+
+        return cubes;
+    }
+
+    //indexes of the cubes
+    std::vector<uint32_t> toIndexes(const std::vector<std::string>& cubes){
+        std::vector<uint32_t> res(cubes.size(), NO_CUBE);
+        std::vector<uint32_t> idx, pos;
+        uint32_t i;
+
+        toIndex(cubes, idx, pos);
+
+        for(i = 0; i < idx.size(); i++)
+            res[pos[i]] = idx[i];
+
+        return res;
+    }
+
+    //solve packed cubes, without the colors
+    std::vector<std::string> solvePacked(const uint8_t packed[], size_t n, bool sorted){
+        std::vector<std::string> res(n, "Error");
+        std::vector<uint32_t> idx, pos;
+        int8_t faces[N_TILES];
+        uint16_t ori, perm;
+        uint32_t i;
+
+        idx.reserve(n);
+        pos.reserve(n);
+
+        for(i = 0; i < n; i++){
+            if(!Tiles::unpack(packed + (size_t)i*PACKED_BYTES, faces) || Tiles::fromFaces(faces, ori, perm) != NO_ERROR)
+                continue;
+
+            idx.push_back(Explore::Scramble::index(ori, perm));
+            pos.push_back(i);
+        }
+
+        solveBatch(idx, pos, res, sorted);
+
+        return res;
+    }
+
+    //solve the indexes, without the tiles
+    std::vector<std::string> solveIndexes(const std::vector<uint32_t>& cubes, bool sorted){
+        std::vector<std::string> res(cubes.size(), "Error");
+        std::vector<uint32_t> idx, pos;
+        uint32_t i;
+
+        idx.reserve(cubes.size());
+        pos.reserve(cubes.size());
+
+        for(i = 0; i < cubes.size(); i++){
+            if(cubes[i] >= CUBE_CASES)
+                continue;
+
+            idx.push_back(cubes[i]);
+            pos.push_back(i);
+        }
+
+        solveBatch(idx, pos, res, sorted);
+
+        return res;
+    }
+
+    //move the indexes in blocks of coordinates
+    bool applyMoves(uint32_t cubes[], size_t n, const std::string& sequence){
+        const size_t block = 4096;
+        uint16_t ori[block], perm[block];
+        std::vector<int8_t> moves;
+        Notation notation;
+        size_t i, j, size;
+
+        if(!notation.parse(sequence, moves))
+            return false;
+
+        if(moves.empty())
+            return true;
+
+        for(i = 0; i < n; i += block){
+            size = std::min(block, n - i);
+
+            //the indexes out of range move the solved cube, that is not stored
+            for(j = 0; j < size; j++){
+                ori[j] = cubes[i+j] < CUBE_CASES ? (uint16_t)(cubes[i+j] / PERM_CASES) : 0;
+                perm[j] = cubes[i+j] < CUBE_CASES ? (uint16_t)(cubes[i+j] % PERM_CASES) : 0;
+            }
+
+            getCoords().moveBatch(ori, perm, (uint32_t)size, moves.data(), (uint32_t)moves.size());
+
+            for(j = 0; j < size; j++)
+                if(cubes[i+j] < CUBE_CASES)
+                    cubes[i+j] = Explore::Scramble::index(ori[j], perm[j]);
+        }
+
+        return true;
+    }
+
+    //solve the indexes of an async batch
+    static void solveAsyncBatch(const uint32_t idx[], uint64_t res[], uint32_t n){
+        Epoch::Guard guard(readers);
+        const Table* t = getReadable();
+
+        if(t == nullptr){
+            std::fill(res, res + n, NOT_LOADED);
+            return;
+        }
+
+        getTable(t)->solve(idx, res, n);
+    }
+
+    //start the async solves
+    bool startAsync(uint32_t maxBatch, uint32_t flushMicros, uint32_t threads){
+        std::lock_guard<std::mutex> lock(asyncMutex);
+
+        if(async.load() != nullptr)
+            return false;
+
+        if(threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        async.store(new Async(solveAsyncBatch, maxBatch, flushMicros, threads));
+
+        return true;
+    }
+
+    //stop the async solves, the solves already pushing end before the delete
+    void stopAsync(){
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        Async* old;
+
+        asyncStopping = true;
+        old = async.exchange(nullptr);
+        asyncReaders.synchronize();
+        delete old;
+        asyncStopping = false;
+    }
+
+    //start the async solves at the first use, not during a stop:
+    //a callback of a worker being joined would wait the stop
+    static void startAsyncOnce(){
+        if(async.load() == nullptr && !asyncStopping.load())
+            startAsync();
+    }
+
+    //solve in background with a future
+    std::future<std::string> solveAsync(const std::string& cube){
+        std::promise<std::string> rejected;
+        Async* a;
+
+        startAsyncOnce();
+
+        Epoch::Guard guard(asyncReaders);
+        a = async.load(std::memory_order_acquire);
+
+        if(a != nullptr)
+            return a->solve(cube);
+
+        rejected.set_value("Error");
+        return rejected.get_future();
+    }
+
+    //solve in background with a callback
+    void solveAsync(const std::string& cube, std::function<void(const std::string&)> callback){
+        Async* a;
+
+        startAsyncOnce();
+
+        {
+            Epoch::Guard guard(asyncReaders);
+            a = async.load(std::memory_order_acquire);
+
+            if(a != nullptr){
+                a->solve(cube, std::move(callback));
+                return;
+            }
+        }
+
+        if(callback)
+            callback("Error");
+    }
+
+    //moves of the corner states, without the depths
+    static const CornerDB& getCornerMoves(){
+        static const CornerDB moves;
+        return moves;
+    }
+
+    //replace the corner database, the old one is unmapped when no lookup reads it
+    static void publishCorners(CornerDB* created){
+        CornerDB* old = corners.exchange(created, std::memory_order_seq_cst);
+
+        cornerReaders.synchronize();
+        delete old;
+    }
+
+    //generate the corner database
+    static CornerDB* generateCorners(uint32_t threads){
+        auto* created = new CornerDB();
+        uint32_t sizes[CORNER_DEPTHS];
+
+        if(threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        if(!created->generate(threads, sizes)){
+            delete created;
+            return nullptr;
+        }
+
+        return created;
+    }
+
+    //generate, write and use the corner database
+    bool writeCornerTable(const std::string& name, uint32_t threads){
+        CornerDB* created = generateCorners(threads);
+        std::lock_guard<std::recursive_mutex> lock(writer);
+
+        if(created == nullptr || !created->write(name)){
+            delete created;
+            return false;
+        }
+
+        publishCorners(created);
+
+        return true;
+    }
+
+    //map the corner database, generate it if the file is not correct
+    bool loadCornerTable(const std::string& name, uint32_t threads){
+        auto* created = new CornerDB();
+
+        if(!created->load(name)){
+            delete created;
+            return writeCornerTable(name, threads);
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(writer);
+        publishCorners(created);
+
+        return true;
+    }
+
+    //unmap the corner database
+    void unloadCornerTable(){
+        std::lock_guard<std::recursive_mutex> lock(writer);
+
+        publishCorners(nullptr);
+    }
+
+    //index of the corners
+    uint32_t cornerIndex(const int8_t perm[8], const int8_t ori[8]){
+        return CornerDB::index(perm, ori);
+    }
+
+    //move a corner index
+    uint32_t cornerMove(uint32_t idx, int8_t move){
+        if(idx >= CORNER_CASES || move < 0 || move >= N_FACE_MOVES)
+            return NO_CUBE;
+
+        return getCornerMoves().move(idx, move);
+    }
+
+    //moves to solve the corners
+    int8_t cornerDepth(uint32_t idx){
+        Epoch::Guard guard(cornerReaders);
+        const CornerDB* db = corners.load(std::memory_order_seq_cst);
+
+        if(db == nullptr || idx >= CORNER_CASES)
+            return -1;
+
+        return db->get(idx);
+    }
+
+    //moves to solve the corners of a batch
+    void cornerDepth(const uint32_t idx[], int8_t res[], size_t n){
+        Epoch::Guard guard(cornerReaders);
+        const CornerDB* db = corners.load(std::memory_order_seq_cst);
+
+        if(db == nullptr){
+            std::fill(res, res + n, (int8_t)-1);
+            return;
+        }
+
+        db->get(idx, res, (uint32_t)n);
+    }
+
+    //distance of the cube
+    int8_t distance(const std::string& cube){
+        Tiles tiles(cube);
+        uint64_t res;
+
+        if(tiles.getError() != NO_ERROR)
+            return -1;
+
+        Epoch::Guard guard(readers);
+        res = lookup(getReadable(), tiles.getOri(), tiles.getPerm());
+
+        if(res == NOT_LOADED)
+            return -1;
+
+        return Explore::Scramble::depth(res);
+    }
+
+    //distance of a batch
+    std::vector<int8_t> distance(const std::vector<std::string>& cubes){
+        std::vector<int8_t> res(cubes.size(), -1), depths;
+        std::vector<uint32_t> idx, pos;
+        uint32_t i;
+
+        toIndex(cubes, idx, pos);
+
+        Epoch::Guard guard(readers);
+        const Table* t = getReadable();
+
+        if(t == nullptr)
+            return res;
+
+        depths.resize(idx.size());
+        getTable(t)->depth(idx.data(), depths.data(), (uint32_t)idx.size());
+
+        for(i = 0; i < idx.size(); i++)
+            res[pos[i]] = depths[i];
+
+        return res;
+    }
+
+    //histogram of all the cubes
+    std::vector<uint32_t> histogram(){
+        std::vector<uint32_t> hist(MAX_DEPTH);
+        int8_t d;
+
+        Epoch::Guard guard(readers);
+        std::shared_ptr<const Depths> depths = getDepths(getReadable());
+
+        if(depths != nullptr)
+            for(d = 0; d < MAX_DEPTH; d++)
+                hist[d] = depths->size(d);
+
+        return hist;
+    }
+
+    //histogram of a batch
+    std::vector<uint32_t> histogram(const std::vector<std::string>& cubes){
+        std::vector<uint32_t> hist(MAX_DEPTH);
+        std::vector<uint32_t> idx, pos;
+        std::vector<int8_t> depths;
+
+        toIndex(cubes, idx, pos);
+
+        Epoch::Guard guard(readers);
+        const Table* t = getReadable();
+
+        if(t == nullptr)
+            return hist;
+
+        depths.resize(idx.size());
+        getTable(t)->depth(idx.data(), depths.data(), (uint32_t)idx.size());
+
+        for(int8_t d : depths)
+            hist[d]++;
+
+        return hist;
+    }
+
+    //export the cubes
+    bool exportCubes(const std::string& name, Format format, uint32_t begin, uint32_t end, uint32_t threads){
+        if(threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::unique_ptr<Explore::Scramble> generated;
+        std::lock_guard<std::recursive_mutex> lock(writer);
+        return getScramble(generated) != nullptr && Export(getScramble(generated), format == CSV_FORMAT).write(name, begin, end, threads);
+    }
+
+    //check all the solutions of the table used by the solves
+    uint32_t verify(uint32_t threads){
+        if(threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        Epoch::Guard guard(readers);
+        const Table* t = getReadable();
+
+        if(t == nullptr)
+            return CUBE_CASES;
+
+        return Verify(getTable(t), getCoords()).check(threads);
+    }
+
+    //cubes of a depth
+    uint32_t countAtDepth(int8_t depth){
+        if(depth < 0 || depth >= MAX_DEPTH)
+            return 0;
+
+        Epoch::Guard guard(readers);
+        std::shared_ptr<const Depths> depths = getDepths(getReadable());
+
+        return depths == nullptr ? 0 : depths->size(depth);
+    }
+
+    //a cube of a depth
+    std::string stateAtDepth(int8_t depth, uint32_t i){
+        if(depth < 0 || depth >= MAX_DEPTH)
+            return "Error";
+
+        Epoch::Guard guard(readers);
+        std::shared_ptr<const Depths> depths = getDepths(getReadable());
+
+        if(depths == nullptr || i >= depths->size(depth))
+            return "Error";
+
+        return toCube(depths->get(depth, i));
+    }
+
+    //random cube of a depth
+    std::string randomAtDepth(int8_t depth, bool atLeast){
+        static thread_local std::mt19937 gen((unsigned)time(nullptr));
+        uint32_t n;
+
+        if(depth < 0 || depth >= MAX_DEPTH)
+            return "Error";
+
+        Epoch::Guard guard(readers);
+        std::shared_ptr<const Depths> depths = getDepths(getReadable());
+
+        if(depths == nullptr)
+            return "Error";
+
+        n = atLeast ? depths->sizeFrom(depth) : depths->size(depth);
+
+        if(n == 0)
+            return "Error";
+
+        return toCube(depths->get(depth, std::uniform_int_distribution<uint32_t>(0, n-1)(gen)));
+    }
+
+    //random cube
+    std::string random(){
+        static bool firstTime = true;
+
+        char cube[N_TILES+1] = "YYYYOOOOGGGGWWWWRRRRBBBB";
+        std::string cubeStr;
+
+        if(firstTime){
+            srand((unsigned)time(nullptr));
+            firstTime = false;
+        }
+
+        for(int8_t i = 0; i < 20; i++)
+            Tiles::moveTiles(cube, rand()%N_MOVES);
+
+        cubeStr = "";
+        cubeStr.append(cube);
+
+        return cubeStr;
+    }
+
+    //apply a scramble to the tiles, the moves in a single permutation
+    static void applyScramble(char cube[], const std::string& s){
+        std::vector<int8_t> moves;
+        uint8_t perm[N_TILES];
+        int8_t move;
+
+        for(size_t i = 0, size = s.length(); i+1 < size; i+=3){
+            switch(s.at(i)){
+                case 'F':
+                    move = 0;
+                    break;
+                case 'R':
+                    move = 3;
+                    break;
+                case 'U':
+                    move = 6;
+                    break;
+                default:
+                    move = 0;
+                    break;
+            }
+
+            move += s.at(i+1)-'0'-1;
+
+            moves.push_back(move);
+        }
+
+        Tiles::sequencePerm(perm, moves.data(), moves.size());
+        Tiles::applyPerm(cube, perm);
+    }
+
+    /**
+     * The random cubes shared by the tests, the last one is wrong.
+     */
+    struct Sample{
+        std::vector<std::string> cubes;
+        std::vector<std::string> sols;
+        std::vector<int8_t> depths;
+    };
+
+    //tests the generation report and the verifier
+    static void testInit(){
+        GenerationReport report;
+        bool ok;
+
+        ok = init(report);
+        assert(ok && report.valid && report.estimatedPeakBytes >= report.treeBytes + report.scrambleBytes);
+
+        for(int8_t i = 0; i < DEPTHS; i++)
+            assert(report.found[i] == (uint32_t)Explore::DEPTH_SIZE[i] && report.hits[i] <= report.probes[i]
+                   && (!report.bottomUp[i] || report.hits[i] == report.found[i]));
+
+        assert(verify() == 0);
+        getScramble()->scrambleArray[CUBE_CASES-1]++;
+        assert(verify(3) > 0);
+        getScramble()->scrambleArray[CUBE_CASES-1]--;
+
+        (void)ok;
+    }
+
+    //tests the batch solves, sorted or not
+    static void testBatch(const Sample& sample){
+        std::vector<std::string> sortedSols = Solver2x2::solve(sample.cubes, true);
+
+        for(uint16_t i = 0; i < sample.cubes.size(); i++){
+            assert(sample.sols[i] == Solver2x2::solve(sample.cubes[i]));
+            assert(sortedSols[i] == sample.sols[i]);
+        }
+    }
+
+    //tests the packed sample.cubes and the indexes, the last cube is wrong
+    static void testPacked(const Sample& sample){
+        std::vector<uint8_t> wire(sample.cubes.size() * PACKED_BYTES);
+        size_t packed;
 
-        {
-            Coords coords;
-            Explore explore(coords, scramble);
-            explore.generate();
+        packed = packCubes(sample.cubes, wire.data());
+        assert(packed == sample.cubes.size() - 1);
+        assert(solvePacked(wire.data(), sample.cubes.size()) == sample.sols && solveIndexes(toIndexes(sample.cubes), true) == sample.sols);
+        assert(Solver2x2::solve(unpackCubes(wire.data(), sample.cubes.size())) == sample.sols);
+
+        (void)packed;
+    }
+
+    //tests the moves applied to the indexes, the wrong cube stays
+    static void testApplyMoves(const Sample& sample){
+        std::vector<uint32_t> moved = toIndexes(sample.cubes), expected;
+        std::vector<std::string> turned(sample.cubes.begin(), sample.cubes.end() - 1);
+        bool applied;
+
+        applied = applyMoves(moved.data(), moved.size(), "R U2 F'");
+
+        for(std::string& c : turned)
+            applyScramble(&c[0], "R1 U2 F3");
+
+        turned.emplace_back("Error");
+        expected = toIndexes(turned);
+        assert(applied && moved == expected);
+        applied = applyMoves(moved.data(), moved.size(), "R Q");
+        assert(!applied && moved == expected);
+
+        (void)applied;
+    }
+
+    //tests the distances and the histograms
+    static void testDistance(const Sample& sample){
+        std::vector<uint32_t> hist;
+
+        hist = Solver2x2::histogram();
+        for(int8_t i = 0; i < MAX_DEPTH; i++)
+            assert(hist[i] == (uint32_t)Explore::DEPTH_SIZE[i]);
+
+        hist = Solver2x2::histogram(sample.cubes);
+        assert(sample.depths.back() == -1);
+
+        for(uint16_t i = 0; i < sample.cubes.size(); i++){
+            assert(sample.depths[i] == Solver2x2::distance(sample.cubes[i]));
+
+            if(sample.depths[i] >= 0){
+                assert(sample.depths[i] == (int8_t)(sample.sols[i].size()+1)/3 && hist[sample.depths[i]] > 0);
+                hist[sample.depths[i]]--;
+            }
         }
+
+        for(int8_t i = 0; i < MAX_DEPTH; i++)
+            assert(hist[i] == 0);
     }
 
-    //deallocate the scramble solver
-    void deinit(){
-        if(scramble == nullptr)
-            return;
+    //tests the moves and the undo of a session
+    static void testSession(const Sample& sample){
+        CubeSession session;
+        bool ok;
+
+        for(uint16_t i = 0; i < 100; i++){
+            ok = session.setCube(sample.cubes[i]);
+            assert(ok && session.solve() == sample.sols[i]);
+
+            for(uint16_t j = 0; j < 20; j++)
+                session.move((int8_t)(rand()%N_MOVES));
+
+            for(uint16_t j = 0; j < 20; j++){
+                ok = session.undo();
+                assert(ok);
+            }
+
+            ok = session.undo();
+            assert(!ok && session.solve() == sample.sols[i]);
 
-        delete scramble;
-        scramble = nullptr;
+            for(size_t j = 0; j < sample.sols[i].size(); j+=3){
+                ok = session.move(sample.sols[i].substr(j, 2));
+                assert(ok);
+            }
+
+            assert(session.distance() == 0);
+        }
+
+        (void)ok;
     }
 
-    //write to file
-    bool writeFile(const std::string& name){
-        std::ofstream file(name);
+    //tests the standard notation and the rotations
+    static void testOptimize(){
+        std::string sequence;
 
-        if(!file)
-            return false;
+        assert(optimize("L") == "R1" && optimize("D'") == "U3" && optimize("B2") == "F2");
+        assert(optimize("y R y'") == "F1" && optimize("R L'") == "" && optimize("x y z") == "");
+        assert(optimize("D R") == optimize("U F") && optimize("R L") == "R2");
+        assert(optimize("R U R' U'") == optimize("R1 U1 R3 U3") && optimize("R Q") == "Error");
 
-        if(scramble == nullptr)
-            init();
+        for(uint16_t i = 0; i < 2000; i++)
+            sequence += moveToStr((int8_t)(rand()%N_MOVES)) + std::string(" ");
 
-        file.write(reinterpret_cast<char *>(scramble->scrambleArray), sizeof(uint64_t) * CUBE_CASES);
-        file.close();
+        sequence.erase(sequence.length()-1);
+        assert(fromScramble(sequence) == fromScramble(optimize(sequence)));
+        assert(fromScramble(invScramble(sequence)) == fromScramble(invScramble(optimize(sequence))));
+    }
 
-        return true;
+    //tests the solutions between two sample.cubes
+    static void testSolveTo(const Sample& sample){
+        for(uint16_t i = 1; i < 100; i++){
+            char from[N_TILES+1];
+
+            strcpy(from, sample.cubes[i-1].c_str());
+            applyScramble(from, solveTo(sample.cubes[i-1], sample.cubes[i]));
+            assert(sample.cubes[i] == from);
+        }
     }
 
-    //read the solver from a file
-    bool loadFile(const std::string& name){
-        std::ifstream file(name);
+    //tests the sample.cubes with unknown tiles
+    static void testMasked(const Sample& sample){
+        std::string cube, sol;
+        uint32_t matched;
 
-        if(!file)
-            return writeFile(name);
+        for(uint16_t i = 0; i < 100; i++){
+            sol = solveMasked(sample.cubes[i], matched);
+            assert(sol == sample.sols[i] && matched == 1);
+            cube = sample.cubes[i];
+
+            for(uint16_t j = 0; j < 6; j++)
+                cube[rand()%N_TILES] = '?';
+
+            sol = solveMasked(cube, matched);
+            assert(distance(fromScramble(invScramble(sol))) <= sample.depths[i] && matched >= 1);
+        }
+
+        sol = solveMasked("YYYY??????????W???R????B", matched);
+        assert(sol == "" && matched == 1296);
+        sol = solveMasked("YYYYOOOOGGGGWWWWRRRR????", matched);
+        assert(sol == "" && matched == 1);
+        sol = solveMasked("YYYYOOOOGGGGWWWWRRRRBBBY", matched);
+        assert(sol == "Error" && matched == 0);
+
+        //the faces like in the solve, not mixed with the colors
+        sol = solveMasked("uuuu??????????D???L????B", matched);
+        assert(sol == "" && matched == 1296);
+        sol = solveMasked("UUUURRRRFFFFDDDDLLLL????", matched);
+        assert(sol == "" && matched == 1);
+        sol = solveMasked("UUUUYYYYFFFFDDDDLLLL????", matched);
+        assert(sol == "Error" && matched == 0);
+        sol = solveMasked("YYYYOOOOGGGGWWWWRRRR???\xff", matched);
+        assert(sol == "Error" && matched == 0);
+    }
+
+    //tests the sample.cubes grouped by depth
+    static void testDepths(){
+        for(int8_t i = 0; i < MAX_DEPTH; i++){
+            assert(countAtDepth(i) == (uint32_t)Explore::DEPTH_SIZE[i]);
+            assert(distance(randomAtDepth(i)) == i && distance(randomAtDepth(i, true)) >= i);
+            assert(distance(stateAtDepth(i, 0)) == i && distance(stateAtDepth(i, countAtDepth(i)-1)) == i);
+        }
+
+        assert(stateAtDepth(MAX_DEPTH-1, countAtDepth(MAX_DEPTH-1)) == "Error" && randomAtDepth(MAX_DEPTH) == "Error");
+    }
+
+    //tests the export of a range split between the threads, read back in both formats
+    static void testExport(){
+        const uint32_t begin = CUBES - 2*EXPORT_BLOCK - 100;
+        std::ifstream file;
+        std::string line, cube, sol;
+        char record[RECORD_SIZE];
+        uint64_t s;
+        uint32_t i, wrong = 0;
+        size_t comma;
+        bool ok;
+
+        ok = exportCubes("test.s2e", BINARY_FORMAT, begin, CUBES, 2);
+        assert(ok);
+        file.open("test.s2e", std::ios::binary);
+
+        for(i = begin; file.read(record, RECORD_SIZE); i++){
+            cube.assign(record, N_TILES);
+            s = 0;
+            sol = "";
 
-        if(scramble != nullptr)
-            deinit();
+            for(int8_t j = 7; j >= 0; j--)
+                s = (s << 8) | (uint8_t)record[N_TILES + j];
 
-        scramble = new Explore::Scramble();
+            for(int8_t j = 0; j < Explore::Scramble::depth(s); j++)
+                sol += (j ? " " : "") + std::string(moveToStr((int8_t)((s >> (4*(j+1))) & 0xF)));
 
-        file.read(reinterpret_cast<char *>(scramble->scrambleArray), sizeof(uint64_t) * CUBE_CASES);
+            wrong += toIndexes({cube})[0] != i || solve(cube) != sol;
+        }
+
+        assert(i == CUBES && wrong == 0);
         file.close();
 
-        return true;
+        ok = exportCubes("test.csv", CSV_FORMAT, begin, CUBES, 2);
+        assert(ok);
+        file.open("test.csv");
+
+        for(i = begin; std::getline(file, line); i++){
+            comma = line.find(',');
+            cube = line.substr(comma+1, N_TILES);
+            sol = line.substr(line.find(',', comma+N_TILES+2)+1);
+
+            wrong += line.substr(0, comma) != std::to_string(i) || solve(cube) != sol
+                    || line.substr(comma+N_TILES+2, line.find(',', comma+N_TILES+2)-comma-N_TILES-2) != std::to_string(distance(cube));
+        }
+
+        assert(i == CUBES && wrong == 0);
+        file.close();
+
+        //the wrong ranges do not truncate the file
+        ok = exportCubes("test.csv", CSV_FORMAT, 10, 5) || exportCubes("test.csv", CSV_FORMAT, 0, CUBES+1);
+        assert(!ok);
+        file.open("test.csv");
+        assert(std::getline(file, line) && line.substr(0, line.find(',')) == std::to_string(begin));
+        file.close();
+
+        std::remove("test.s2e");
+        std::remove("test.csv");
+
+        (void)ok;
     }
 
-    //solve the cube
-    std::string solve(const std::string& cube){
-        Tiles tiles(cube);
+    //tests the c interface, the last cube is wrong
+    static void testCInterface(const Sample& sample){
+        std::vector<uint8_t> cMoves(1001 * S2X2_MAX_MOVES);
+        std::vector<uint8_t> fileMoves;
+        std::vector<int8_t> cLengths(1001);
+        S2x2Solver* solver;
+        std::string packed, sol;
+        uint32_t valid;
+        int32_t written;
 
-        if(tiles.getError() != NO_ERROR)
-            return "Error";
+        for(uint16_t i = 0; i < 1000; i++)
+            packed += sample.cubes[i];
+
+        packed += std::string(S2X2_TILES, 'Y');
+
+        solver = s2x2_create(nullptr);
+        assert(solver != nullptr);
+        valid = s2x2_solve_batch(solver, packed.data(), 1001, cMoves.data(), cLengths.data());
+        assert(valid == 1000 && cLengths[1000] == S2X2_ERROR);
+
+        for(uint16_t i = 0; i < 1000; i++){
+            sol = "";
+
+            for(int8_t j = 0; j < cLengths[i]; j++)
+                sol += (j ? " " : "") + std::string(s2x2_move_name(cMoves[i*S2X2_MAX_MOVES + j]));
+
+            assert(sol == sample.sols[i] && (cLengths[i] == S2X2_MAX_MOVES || cMoves[i*S2X2_MAX_MOVES + cLengths[i]] == S2X2_NO_MOVE));
+        }
+
+        cLengths.assign(1001, 0);
+        valid = s2x2_distance_batch(solver, packed.data(), 1001, cLengths.data());
+        assert(valid == 1000);
+
+        for(uint16_t i = 0; i < 1000; i++)
+            assert(cLengths[i] == distance(sample.cubes[i]));
+
+        assert(cLengths[1000] == S2X2_ERROR && std::string(s2x2_move_name(S2X2_NO_MOVE)).empty());
+        assert(s2x2_distance_batch(nullptr, packed.data(), 1001, cLengths.data()) == (uint32_t)S2X2_ERROR);
+
+        //the table written by a solver is read by a new one, with the same solutions
+        written = s2x2_write(solver, "test.s2x");
+        assert(written == 1 && s2x2_write(nullptr, "test.s2x") == 0);
+        s2x2_destroy(solver);
 
-        return Solver2x2::Explore::convert(scramble->solve(tiles.getOri(), tiles.getPerm()));
+        solver = s2x2_create("test.s2x");
+        assert(solver != nullptr);
+        fileMoves.resize(cMoves.size());
+        valid = s2x2_solve_batch(solver, packed.data(), 1001, fileMoves.data(), cLengths.data());
+        assert(valid == 1000 && cLengths[1000] == S2X2_ERROR && fileMoves == cMoves);
+        s2x2_destroy(solver);
+        std::remove("test.s2x");
+
+        (void)valid;
+        (void)written;
     }
 
-    //random cube
-    std::string random(){
-        static bool firstTime = true;
+    //tests the small tables, the solutions are different but with the same length
+    static void testBackends(const Sample& sample){
+        std::string sol;
+        Backend advised;
+        size_t advisedBytes = SIZE_MAX;
+        bool ok;
 
-        char cube[N_TILES+1] = "YYYYOOOOGGGGWWWWRRRRBBBB";
-        std::string cubeStr;
+        for(int8_t type = DEPTH_BACKEND; type <= BLOCK_BACKEND; type++){
+            ok = setBackend((Backend)type);
+            assert(ok && currentBackend() == type);
 
-        if(firstTime){
-            srand((unsigned)time(nullptr));
-            firstTime = false;
+            for(uint16_t i = 0; i < 1000; i++){
+                sol = solve(sample.cubes[i]);
+                assert(sol.size() == sample.sols[i].size() && fromScramble(invScramble(sol)) == sample.cubes[i]);
+            }
+
+            assert(distance(sample.cubes) == sample.depths && countAtDepth(MAX_DEPTH-1) == (uint32_t)Explore::DEPTH_SIZE[MAX_DEPTH-1]);
+            ok = writeBackend("test.s2b") && loadBackend((Backend)type, "test.s2b");
+            assert(ok && currentBackend() == type && solve(sample.cubes[0]).size() == sample.sols[0].size());
+
+            //the search of the other tables takes too long for the tests
+            if(type == DEPTH_BACKEND || type == BLOCK_BACKEND)
+                assert(verify(3) == 0);
         }
 
-        for(int8_t i = 0; i < 20; i++)
-            Tiles::moveTiles(cube, rand()%N_MOVES);
+        //the table read is checked, not the one generated again
+        ok = setBackend(DEPTH_BACKEND) && writeBackend("test.s2b");
+        assert(ok);
 
-        cubeStr = "";
-        cubeStr.append(cube);
+        {
+            std::fstream broken("test.s2b", std::ios::binary | std::ios::in | std::ios::out);
+            char byte;
 
-        return cubeStr;
+            broken.seekg(-CUBE_CASES / 4, std::ios::end);
+            broken.read(&byte, 1);
+            byte ^= 0x33;
+            broken.seekp(-CUBE_CASES / 4, std::ios::end);
+            broken.write(&byte, 1);
+        }
+
+        ok = loadBackend(DEPTH_BACKEND, "test.s2b");
+        assert(ok && verify(3) > 0);
+        ok = setBackend(BLOCK_BACKEND) && writeBackend("test.s2b") && loadBackend(BLOCK_BACKEND, "test.s2b");
+        assert(ok);
+
+        //the mapped blocks give the same solutions of the full table
+        for(uint16_t i = 0; i < 1000; i++)
+            assert(solve(sample.cubes[i]) == sample.sols[i]);
+
+        //the mapped file is replaced, not truncated
+        ok = writeBackend("test.s2b");
+        assert(ok && solve(sample.cubes[0]) == sample.sols[0]);
+        ok = loadBackend(BLOCK_BACKEND, "test.s2b");
+        assert(ok && solve(sample.cubes[1]) == sample.sols[1]);
+
+        std::remove("test.s2b");
+
+        //the solutions generated for a small table are not kept
+        assert(histogram() == std::vector<uint32_t>(Explore::DEPTH_SIZE, Explore::DEPTH_SIZE + MAX_DEPTH));
+        assert(getScramble() == nullptr);
+        ok = setBackend(FULL_BACKEND);
+        assert(ok && solve(sample.cubes[0]) == sample.sols[0]);
+
+        //only the memory decides, the times change with the machine
+        advised = adviseBackend(1 << 20);
+
+        for(const BackendStats& s : benchmarkBackends(1000))
+            if(s.backend == advised)
+                advisedBytes = s.bytes;
+
+        assert(advisedBytes <= (1 << 20));
+
+        assert(adviseBackend(0) == MEET_BACKEND && adviseBackend(SIZE_MAX, 1e12) == MEET_BACKEND);
+
+        (void)ok;
+        (void)advisedBytes;
+    }
+
+    //tests the table replaced while other threads solve
+    static void testHotSwap(const Sample& sample){
+        std::atomic<bool> stop{false};
+        std::atomic<uint32_t> wrong{0};
+        std::vector<std::thread> solvers;
+        bool ok;
+
+        ok = writeFile("test.s2c");
+        assert(ok);
+
+        for(uint16_t k = 0; k < 2; k++)
+            solvers.emplace_back([&, k]{
+                for(uint16_t i = k; !stop; i = (uint16_t)((i + 1) % 1000))
+                    if(solve(sample.cubes[i]).size() != sample.sols[i].size())
+                        wrong++;
+            });
+
+        for(int8_t k = 0; k < 3; k++){
+            ok = setBackend(MEET_BACKEND) && loadFile("test.s2c");
+            assert(ok);
+        }
+
+        stop = true;
+
+        for(std::thread& t : solvers)
+            t.join();
+
+        assert(wrong == 0 && currentBackend() == FULL_BACKEND);
+        std::remove("test.s2c");
+
+        (void)ok;
+    }
+
+    //tests the async solves, the repeated sample.cubes are solved once in a batch
+    static void testAsync(const Sample& sample){
+        std::vector<std::future<std::string>> futures;
+        std::atomic<uint32_t> wrong{0};
+        std::atomic<uint32_t> called{0};
+        bool ok;
+
+        ok = startAsync(64, 500, 2);
+        assert(ok);
+        ok = startAsync();
+        assert(!ok);
+
+        for(uint16_t i = 0; i < 1000; i++)
+            futures.push_back(solveAsync(sample.cubes[i % 500]));
+
+        futures.push_back(solveAsync("Error"));
+        solveAsync(sample.cubes[1], [&](const std::string& sol){
+            wrong += sol != sample.sols[1];
+            called++;
+        });
+
+        for(uint16_t i = 0; i < 1000; i++)
+            assert(futures[i].get() == sample.sols[i % 500]);
+
+        assert(futures[1000].get() == "Error");
+        stopAsync();
+        assert(called == 1 && wrong == 0);
+
+        //a callback during the stop gets "Error", the stopping threads are not started again
+        startAsync(64, 500, 1);
+        solveAsync(sample.cubes[2], [&](const std::string&){
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            solveAsync(sample.cubes[3], [&](const std::string& sol){
+                wrong += sol != "Error";
+                called++;
+            });
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        stopAsync();
+        assert(called == 2 && wrong == 0);
+
+        //the solves of many threads while the threads are stopped and started again
+        std::thread stopper([&]{
+            for(uint8_t k = 0; k < 20; k++){
+                stopAsync();
+                startAsync(64, 100, 2);
+            }
+        });
+        std::vector<std::thread> clients;
+
+        for(uint8_t t = 0; t < 4; t++){
+            clients.emplace_back([&, t]{
+                for(uint16_t i = 0; i < 2000; i++){
+                    std::string sol = solveAsync(sample.cubes[(t*2000 + i) % 1000]).get();
+                    wrong += sol != "Error" && sol != sample.sols[(t*2000 + i) % 1000];
+                }
+            });
+        }
+
+        stopper.join();
+
+        for(std::thread& client : clients)
+            client.join();
+
+        stopAsync();
+        assert(wrong == 0);
+
+        (void)ok;
+    }
+
+    //tests the file ordered by depth, the table read is the same
+    static void testDepthFile(const Sample& sample){
+        std::unique_ptr<Explore::Scramble> saved(getScramble()->clone());
+        bool ok;
+
+        ok = writeDepthFile("test.s2d") && loadDepthFile("test.s2d");
+        assert(ok && solve(sample.cubes[0]) == sample.sols[0] && distance(sample.cubes[1]) == (int8_t)sample.depths[1]);
+        assert(histogram() == std::vector<uint32_t>(Explore::DEPTH_SIZE, Explore::DEPTH_SIZE + MAX_DEPTH));
+        assert(loadedDepths() == MAX_DEPTH);
+        assert(memcmp(saved->scrambleArray, getScramble()->scrambleArray, sizeof(uint64_t) * CUBE_CASES) == 0);
+        assert(!loadFailed());
+
+        //a broken record of a deep cube, the table is generated again
+        {
+            std::fstream broken("test.s2d", std::ios::binary | std::ios::in | std::ios::out);
+            const uint32_t record = UINT32_MAX;
+
+            broken.seekp(-(std::streamoff)sizeof(record), std::ios::end);
+            broken.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        }
+
+        ok = loadDepthFile("test.s2d");
+        assert(ok && distance(sample.cubes[1]) == (int8_t)sample.depths[1] && solve(sample.cubes[0]).size() == sample.sols[0].size());
+        assert(histogram() == std::vector<uint32_t>(Explore::DEPTH_SIZE, Explore::DEPTH_SIZE + MAX_DEPTH));
+        assert(loadFailed() && loadedDepths() == MAX_DEPTH && verify() == 0);
+        std::remove("test.s2d");
+
+        (void)ok;
+        (void)sample;
+    }
+
+    //tests the cheapest optimal solutions, never more expensive than the first ones
+    static void testCosts(const Sample& sample){
+        std::unique_ptr<Explore::Scramble> saved(getScramble()->clone());
+        MoveCosts costs = ergonomicCosts();
+        uint32_t cheaper = 0;
+        bool ok;
+
+        ok = setMoveCosts(costs, 3);
+        assert(ok && verify() == 0 && currentBackend() == FULL_BACKEND);
+
+        for(uint32_t i = 0; i < CUBE_CASES; i++){
+            assert(Explore::Scramble::depth(getScramble()->scrambleArray[i]) == Explore::Scramble::depth(saved->scrambleArray[i]));
+            assert(Costs::cost(getScramble()->scrambleArray[i], costs) <= Costs::cost(saved->scrambleArray[i], costs));
+
+            if(Costs::cost(getScramble()->scrambleArray[i], costs) < Costs::cost(saved->scrambleArray[i], costs))
+                cheaper++;
+        }
+
+        assert(cheaper > 0 && solve(sample.cubes[0]).size() == sample.sols[0].size());
+
+        (void)ok;
+        (void)sample;
+        (void)cheaper;
+    }
+
+    //tests the goal tables: the solved cube with a U turn and the first layer
+    static void testGoals(const Sample& sample){
+        const std::string layer = "??????OO??GGWWWW??RR??BB";
+        std::vector<std::string> auf = {fromScramble(""), fromScramble("U1"), fromScramble("U2"), fromScramble("U3")};
+        std::string reached;
+        bool ok;
+
+        ok = makeGoal("auf", auf) && makeGoal("layer", std::vector<std::string>{layer});
+        assert(ok);
+        ok = makeGoal("layer2", [&](const std::string& cube){
+            for(uint8_t i = 0; i < N_TILES; i++)
+                if(layer[i] != WILDCARD && layer[i] != cube[i])
+                    return false;
+
+            return true;
+        });
+        assert(ok);
+        ok = makeGoal("none", std::vector<std::string>{"Error"}) || makeGoal("none", std::vector<std::string>{});
+        assert(!ok);
+        assert(goalNames() == std::vector<std::string>({"auf", "layer", "layer2"}));
+
+        for(uint16_t i = 0; i < 100; i++){
+            char goal[N_TILES+1];
+            std::string sol = solveGoal(sample.cubes[i], "auf");
+            size_t nearest = MAX_DEPTH;
+
+            strcpy(goal, sample.cubes[i].c_str());
+            applyScramble(goal, sol);
+            assert(std::find(auf.begin(), auf.end(), std::string(goal)) != auf.end());
+
+            //a move and a space each
+            for(const std::string& to : auf)
+                nearest = std::min(nearest, (solveTo(sample.cubes[i], to).size() + 1) / 3);
+
+            assert((sol.size() + 1) / 3 == nearest);
+            assert(solveGoal(sample.cubes[i], "layer").size() == solveGoal(sample.cubes[i], "layer2").size());
+            assert(solveGoal(sample.cubes[i], {"auf", "layer"}, reached).size() <= sol.size() && !reached.empty());
+        }
+
+        assert(solveGoal(auf[2], {}, reached) == "" && reached == "auf");
+        assert(solveGoal(sample.cubes[0], "none") == "Error" && solveGoal("Error", "auf") == "Error");
+
+        //the tables read are the same
+        reached = solveGoal(sample.cubes[0], "layer");
+        ok = writeGoal("layer", "test.s2g") && !writeGoal("none", "test.s2g");
+        assert(ok);
+        removeGoal("layer");
+        assert(solveGoal(sample.cubes[0], "layer") == "Error");
+        ok = loadGoal("layer", "test.s2g");
+        assert(ok && solveGoal(sample.cubes[0], "layer") == reached);
+        std::remove("test.s2g");
+
+        removeGoal("auf");
+        removeGoal("layer");
+        removeGoal("layer2");
+        assert(goalNames().empty());
+
+        (void)ok;
+    }
+
+    //tests the corner pattern database written, mapped and read, with the known count of every depth
+    static void testCorners(){
+        static const uint32_t CORNER_SIZE[CORNER_DEPTHS] = {
+            1, 18, 243, 2874, 28000, 205416, 1168516, 5402628, 20776176, 45391616, 15139616, 64736
+        };
+        std::vector<uint32_t> idx(1 << 16);
+        std::vector<int8_t> res(idx.size());
+        uint32_t count[CORNER_DEPTHS]{};
+        std::atomic<bool> stop{false};
+        std::atomic<uint32_t> wrong{0};
+        std::thread reader;
+        uint32_t i, j, n;
+        bool ok;
+
+        ok = writeCornerTable("test.s3c") && loadCornerTable("test.s3c");
+        assert(ok && cornerDepth(0) == 0 && cornerDepth(CORNER_CASES) == -1);
+
+        for(i = 0; i < CORNER_CASES; i += n){
+            n = std::min((uint32_t)idx.size(), CORNER_CASES - i);
+
+            for(j = 0; j < n; j++)
+                idx[j] = i + j;
+
+            cornerDepth(idx.data(), res.data(), n);
+
+            for(j = 0; j < n; j++)
+                if(res[j] >= 0 && res[j] < CORNER_DEPTHS)
+                    count[res[j]]++;
+        }
+
+        for(int8_t d = 0; d < CORNER_DEPTHS; d++)
+            assert(count[d] == CORNER_SIZE[d]);
+
+        //the mapped file is replaced while it is read
+        reader = std::thread([&]{
+            for(uint32_t k = 0; !stop; k = (k + 7919) % CORNER_CASES)
+                if(cornerDepth(k) < 0)
+                    wrong++;
+        });
+
+        ok = writeCornerTable("test.s3c");
+        stop = true;
+        reader.join();
+        assert(ok && wrong == 0 && cornerDepth(cornerMove(0, 3)) == 1);
+
+        unloadCornerTable();
+        assert(cornerDepth(0) == -1);
+        std::remove("test.s3c");
+
+        (void)ok;
+        (void)CORNER_SIZE;
+    }
+
+    //tests the calls without solver
+    static void testWithoutSolver(const Sample& sample){
+        CubeSession session;
+
+        deinit();
+        assert(session.distance() == -1 && session.solve() == "Error");
+        assert(optimize("R U") == "Error" && solveTo(sample.cubes[0], sample.cubes[1]) == "Error");
+
+        (void)sample;
     }
 
     //tests all
     void tests(){
         Coords coords;
         std::string cube;
+        Sample sample;
 
-        init();
+        testInit();
 
         Tiles::test();
+        Epoch::test();
         testMoves();
         coords.test();
+        getCornerMoves().test();
+        assert(cornerMove(cornerMove(0, 13), 12) == cornerMove(0, 14) && cornerMove(0, N_FACE_MOVES) == NO_CUBE);
 
         for(uint16_t i = 0; i < 1000; i++){
             cube = random();
             assert(Solver2x2::fromScramble(Solver2x2::invScramble(Solver2x2::solve(cube))) == cube);
+            sample.cubes.push_back(cube);
         }
 
-        deinit();
+        sample.cubes.emplace_back("Error");
+        sample.sols = Solver2x2::solve(sample.cubes);
+        sample.depths = Solver2x2::distance(sample.cubes);
+
+        testBatch(sample);
+        testPacked(sample);
+        testApplyMoves(sample);
+        testDistance(sample);
+        testSession(sample);
+        testOptimize();
+        testSolveTo(sample);
+        testMasked(sample);
+        testDepths();
+        testExport();
+        testCInterface(sample);
+        testBackends(sample);
+        testHotSwap(sample);
+        testAsync(sample);
+        testDepthFile(sample);
+        testCosts(sample);
+        testGoals(sample);
+        testCorners();
+        testWithoutSolver(sample);
     }
 
     //inverse scramble
@@ -138,10 +2101,10 @@ namespace Solver2x2{
 
         inv = "";
 
-        for(int8_t i = s.size()-1; i > 0; i-=3){
-            inv += s.at(i-1);
+        for(size_t i = s.size(); i >= 2; i = i > 3 ? i-3 : 0){
+            inv += s.at(i-2);
 
-            switch(s.at(i)-'0'){
+            switch(s.at(i-1)-'0'){
                 case 1:
                     inv += "3 ";
                     break;
@@ -156,7 +2119,8 @@ namespace Solver2x2{
             }
         }
 
-        inv.erase(inv.length()-1);
+        if(!inv.empty())
+            inv.erase(inv.length()-1);
 
         return inv;
     }
@@ -165,32 +2129,128 @@ namespace Solver2x2{
     std::string fromScramble(const std::string& s){
         char cube[N_TILES+1] = "YYYYOOOOGGGGWWWWRRRRBBBB";
         std::string cubeStr;
-        int8_t move;
-
-        for(int8_t i = 0, size = s.length(); i < size; i+=3){
-            switch(s.at(i)){
-                case 'F':
-                    move = 0;
-                    break;
-                case 'R':
-                    move = 3;
-                    break;
-                case 'U':
-                    move = 6;
-                    break;
-                default:
-                    move = 0;
-                    break;
-            }
-
-            move += s.at(i+1)-'0'-1;
 
-            Tiles::moveTiles(cube, move);
-        }
+        applyScramble(cube, s);
 
         cubeStr = "";
         cubeStr.append(cube);
 
         return cubeStr;
     }
+
+    //optimal equivalent sequence
+    std::string optimize(const std::string& sequence){
+        std::vector<int8_t> moves;
+        Notation notation;
+        Coords& coords = getCoords();
+        uint64_t res;
+        uint16_t ori, perm;
+
+        if(!notation.parse(sequence, moves))
+            return "Error";
+
+        ori = 0;
+        perm = 0;
+
+        for(int8_t move : moves){
+            ori = coords.moveCOri(ori, move);
+            perm = coords.moveCPerm(perm, move);
+        }
+
+        Epoch::Guard guard(readers);
+        res = lookup(getReadable(), ori, perm);
+
+        if(res == NOT_LOADED)
+            return "Error";
+
+        return invScramble(Explore::convert(res));
+    }
+
+    //start from the solved cube
+    CubeSession::CubeSession() : ori(0), perm(0){}
+
+    //start from a cube
+    bool CubeSession::setCube(const std::string& cube){
+        Tiles tiles(cube);
+
+        if(tiles.getError() != NO_ERROR)
+            return false;
+
+        ori = tiles.getOri();
+        perm = tiles.getPerm();
+        history.clear();
+
+        return true;
+    }
+
+    //back to the solved cube
+    void CubeSession::reset(){
+        ori = 0;
+        perm = 0;
+        history.clear();
+    }
+
+    //apply a move
+    bool CubeSession::move(int8_t move){
+        if(move < 0 || move >= N_MOVES)
+            return false;
+
+        ori = getCoords().moveCOri(ori, move);
+        perm = getCoords().moveCPerm(perm, move);
+        history.push_back(move);
+
+        return true;
+    }
+
+    //apply a move string
+    bool CubeSession::move(const std::string& move){
+        for(int8_t i = 0; i < N_MOVES; i++)
+            if(move == moveToStr(i))
+                return this->move(i);
+
+        return false;
+    }
+
+    //undo the last move
+    bool CubeSession::undo(){
+        int8_t move;
+
+        if(history.empty())
+            return false;
+
+        move = invMove(history.back());
+        history.pop_back();
+
+        ori = getCoords().moveCOri(ori, move);
+        perm = getCoords().moveCPerm(perm, move);
+
+        return true;
+    }
+
+    //distance from solved
+    int8_t CubeSession::distance() const{
+        Epoch::Guard guard(readers);
+        uint64_t res = lookup(getReadable(), ori, perm);
+
+        if(res == NOT_LOADED)
+            return -1;
+
+        return Explore::Scramble::depth(res);
+    }
+
+    //solve the session cube
+    std::string CubeSession::solve() const{
+        Epoch::Guard guard(readers);
+        uint64_t res = lookup(getReadable(), ori, perm);
+
+        if(res == NOT_LOADED)
+            return "Error";
+
+        return Explore::convert(res);
+    }
+
+    //moves applied
+    size_t CubeSession::size() const{
+        return history.size();
+    }
 }
@@ -0,0 +1,169 @@
+/**
+ * This file contains the C interface of the solver.
+ * Every solver has its own scramble table, so more
+ * solvers can be used at the same time.
+ */
+
+#include <new>
+#include <string>
+#include <vector>
+#include "Solver2x2_c.h"
+#include "Explore.h"
+#include "Coords.h"
+#include "Tiles.h"
+
+using namespace Solver2x2;
+
+//the opaque solver
+struct S2x2Solver{
+    Explore::Scramble* scramble;
+};
+
+//convert the packed cubes into indexes, the wrong cubes get S2X2_ERROR
+static void toIndex(const char* cubes, uint32_t n, std::vector<uint32_t>& idx, std::vector<uint32_t>& pos, int8_t* lengths){
+    uint32_t i;
+
+    idx.reserve(n);
+    pos.reserve(n);
+
+    for(i = 0; i < n; i++){
+        Tiles tiles(std::string(cubes + (size_t)i*S2X2_TILES, S2X2_TILES));
+
+        if(tiles.getError() != NO_ERROR){
+            lengths[i] = S2X2_ERROR;
+            continue;
+        }
+
+        idx.push_back(Explore::Scramble::index(tiles.getOri(), tiles.getPerm()));
+        pos.push_back(i);
+    }
+}
+
+extern "C" {
+
+    //create a solver
+    S2x2Solver* s2x2_create(const char* name){
+        auto* solver = new (std::nothrow) S2x2Solver();
+
+        if(solver == nullptr)
+            return nullptr;
+
+        //no exception can cross the interface
+        try{
+            solver->scramble = new Explore::Scramble();
+
+            if(name != nullptr && solver->scramble->read(name))
+                return solver;
+
+            {
+                Coords coords;
+                Explore explore(coords, solver->scramble);
+
+                if(!explore.generate()){
+                    s2x2_destroy(solver);
+                    return nullptr;
+                }
+            }
+
+            if(name != nullptr)
+                solver->scramble->write(name);
+        }catch(...){
+            s2x2_destroy(solver);
+            return nullptr;
+        }
+
+        return solver;
+    }
+
+    //destroy a solver
+    void s2x2_destroy(S2x2Solver* solver){
+        if(solver == nullptr)
+            return;
+
+        delete solver->scramble;
+        delete solver;
+    }
+
+    //write the table
+    int32_t s2x2_write(const S2x2Solver* solver, const char* name){
+        if(solver == nullptr || name == nullptr)
+            return 0;
+
+        return solver->scramble->write(name) ? 1 : 0;
+    }
+
+    //solve a batch of cubes
+    uint32_t s2x2_solve_batch(const S2x2Solver* solver, const char* cubes, uint32_t n, uint8_t* moves, int8_t* lengths){
+        std::vector<uint32_t> idx, pos;
+        std::vector<uint64_t> res;
+        uint64_t s;
+        uint8_t* out;
+        size_t i;
+        int8_t j, size;
+
+        if(solver == nullptr || cubes == nullptr || moves == nullptr || lengths == nullptr)
+            return (uint32_t)S2X2_ERROR;
+
+        //no exception can cross the interface
+        try{
+            for(i = 0; i < (size_t)n*S2X2_MAX_MOVES; i++)
+                moves[i] = S2X2_NO_MOVE;
+
+            toIndex(cubes, n, idx, pos, lengths);
+
+            res.resize(idx.size());
+            solver->scramble->solve(idx.data(), res.data(), (uint32_t)idx.size());
+
+            //unpack the moves, the first is in the lowest bits after the size
+            for(i = 0; i < idx.size(); i++){
+                s = res[i];
+                size = Explore::Scramble::depth(s);
+                out = moves + (size_t)pos[i]*S2X2_MAX_MOVES;
+
+                for(j = 0; j < size; j++){
+                    s >>= 4;
+                    out[j] = (uint8_t)(s & 0xF);
+                }
+
+                lengths[pos[i]] = size;
+            }
+        }catch(...){
+            return (uint32_t)S2X2_ERROR;
+        }
+
+        return (uint32_t)idx.size();
+    }
+
+    //distance of a batch of cubes
+    uint32_t s2x2_distance_batch(const S2x2Solver* solver, const char* cubes, uint32_t n, int8_t* lengths){
+        std::vector<uint32_t> idx, pos;
+        std::vector<int8_t> res;
+        size_t i;
+
+        if(solver == nullptr || cubes == nullptr || lengths == nullptr)
+            return (uint32_t)S2X2_ERROR;
+
+        //no exception can cross the interface
+        try{
+            toIndex(cubes, n, idx, pos, lengths);
+
+            res.resize(idx.size());
+            solver->scramble->depth(idx.data(), res.data(), (uint32_t)idx.size());
+
+            for(i = 0; i < idx.size(); i++)
+                lengths[pos[i]] = res[i];
+        }catch(...){
+            return (uint32_t)S2X2_ERROR;
+        }
+
+        return (uint32_t)idx.size();
+    }
+
+    //name of a move
+    const char* s2x2_move_name(uint8_t move){
+        if(move >= N_MOVES)
+            return "";
+
+        return moveToStr((int8_t)move);
+    }
+}
@@ -24,16 +24,15 @@
 #include <cstring>
 #include <cassert>
 #include "Tiles.h"
+#include "Simd.h"
 
 namespace Solver2x2 {
 
     typedef void (*move_tile_f)(char tiles[]);
+    typedef void (*shuffle_f)(uint8_t data[], const uint8_t perm[]);
 
     //convert tiles into coordinates
     Tiles::Tiles(const std::string &cube) {
-        std::string newCube;
-        std::string corners[N_CORNERS];
-
         error = NO_ERROR;
 
         //check if the number of tiles is correct
@@ -42,18 +41,8 @@ namespace Solver2x2 {
             return;
         }
 
-        //convert to standard tiles
-        newCube = stdTiles(cube);
-
-        if (error != NO_ERROR)
-            return;
-
-        //convert to corners
-        toCorner(corners, newCube);
-
-        //get coordinates
-        perm = toPerm(corners);
-        ori = toOrient(corners);
+        //check and get coordinates
+        error = validate(cube.data(), ori, perm);
     }
 
     //eventually error
@@ -71,88 +60,245 @@ namespace Solver2x2 {
         return ori;
     }
 
-    //convert corners into permutation
-    uint16_t Tiles::toPerm(std::string *c) {
-        std::string cStr[N_CORNERS];
-        int8_t corners[N_CORNERS];
-        int8_t i, j;
+    //the opposite faces, in the order of FACE_COLORS
+    static const int8_t OPPOSITE[N_FACES] = {3, 4, 5, 0, 1, 2};
 
-        for (i = 0; i < N_CORNERS; i++) {
-            cStr[i] = c[i];
-            std::sort(cStr[i].begin(), cStr[i].end());
-        }
+    //the corner and the twist of three faces read in the order of C_ORDER, -1 if they are not a corner
+    struct CornerKeys{
+        int8_t corner[N_FACES*N_FACES*N_FACES];
+        int8_t twist[N_FACES*N_FACES*N_FACES];
+
+        CornerKeys(){
+            int8_t i, n, t, face[C_STATES], read[C_STATES];
 
-        for (i = 0; i < N_CORNERS; i++) {
-            for (j = 0; j < N_CORNERS; j++) {
-                if (cStr[i] == CORNERS[j]) {
-                    corners[i] = j;
-                    break;
+            memset(corner, -1, sizeof(corner));
+            memset(twist, 0, sizeof(twist));
+
+            for(i = 0; i < N_CORNERS; i++){
+                for(n = 0; n < C_STATES; n++)
+                    face[n] = (int8_t)(strchr(FACE_COLORS[0], CORNER_FACES[i][n]) - FACE_COLORS[0]);
+
+                //the tile (n+twist)%3 has the face n
+                for(t = 0; t < C_STATES; t++){
+                    for(n = 0; n < C_STATES; n++)
+                        read[(n+t)%C_STATES] = face[n];
+
+                    corner[(read[0]*N_FACES + read[1])*N_FACES + read[2]] = i;
+                    twist[(read[0]*N_FACES + read[1])*N_FACES + read[2]] = t;
                 }
             }
         }
+    };
 
-        return Coords::compCPerm(corners);
-    }
+    static const CornerKeys CORNER_KEYS;
 
-    //convert corners into orientation
-    uint16_t Tiles::toOrient(std::string *c) {
-        int8_t corners[N_CORNERS];
-        int8_t i, j;
+    //the lower case and the opposite color of every char, 0 if it is not a color
+    struct ColorTables{
+        char lower[256];
+        char opposite[2][256];
 
-        for (i = 0; i < N_CORNERS; i++) {
-            corners[i] = 0;
+        ColorTables(){
+            const char* LETTERS[2] = {"udrlfb", "dulrbf"};
+            int16_t c;
+            int8_t i;
 
-            for (j = 0; j < C_STATES; j++) {
-                if (c[i].at(j) == UP || c[i].at(j) == DOWN) {
-                    corners[i] = j;
-                    break;
-                }
+            memset(opposite, 0, sizeof(opposite));
+
+            for(c = 0; c < 256; c++)
+                lower[c] = (char)(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+
+            for(i = 0; i < N_FACES; i++){
+                opposite[0][(uint8_t)INV_COLOR[0][i]] = INV_COLOR[1][i];
+                opposite[1][(uint8_t)LETTERS[0][i]] = LETTERS[1][i];
             }
         }
+    };
+
+    static const ColorTables COLOR_TABLES;
+
+    //the faces of the tiles, false if a tile has no color of the faces
+    static bool classify(const char cube[], const char colors[N_FACES], int8_t faces[]){
+        int8_t i;
+
+#ifdef SIMD_X86
+        const __m128i upper = _mm_set1_epi8('A' - 1), lower = _mm_set1_epi8('Z' + 1), caseBit = _mm_set1_epi8(0x20);
+        __m128i lo = _mm_loadu_si128((const __m128i*)cube);
+        __m128i hi = _mm_loadl_epi64((const __m128i*)(cube + 16));
+        __m128i idLo = _mm_setzero_si128(), idHi = _mm_setzero_si128(), eqLo, eqHi, face;
+        __m128i anyLo = _mm_setzero_si128(), anyHi = _mm_setzero_si128();
+
+        //lower case only the letters
+        lo = _mm_or_si128(lo, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(lo, upper), _mm_cmplt_epi8(lo, lower)), caseBit));
+        hi = _mm_or_si128(hi, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(hi, upper), _mm_cmplt_epi8(hi, lower)), caseBit));
+
+        //the colors are different, so a tile matches at most a face
+        for(i = 0; i < N_FACES; i++){
+            face = _mm_set1_epi8(colors[i]);
+            eqLo = _mm_cmpeq_epi8(lo, face);
+            eqHi = _mm_cmpeq_epi8(hi, face);
+
+            idLo = _mm_or_si128(idLo, _mm_and_si128(eqLo, _mm_set1_epi8(i)));
+            idHi = _mm_or_si128(idHi, _mm_and_si128(eqHi, _mm_set1_epi8(i)));
+            anyLo = _mm_or_si128(anyLo, eqLo);
+            anyHi = _mm_or_si128(anyHi, eqHi);
+        }
 
-        return Coords::comCOri(corners);
+        _mm_storeu_si128((__m128i*)faces, idLo);
+        _mm_storel_epi64((__m128i*)(faces + 16), idHi);
+
+        return _mm_movemask_epi8(anyLo) == 0xFFFF && (_mm_movemask_epi8(anyHi) & 0xFF) == 0xFF;
+#else
+        int8_t j;
+
+        for(i = 0; i < N_TILES; i++){
+            faces[i] = -1;
+
+            for(j = 0; j < N_FACES; j++)
+                if(COLOR_TABLES.lower[(uint8_t)cube[i]] == colors[j])
+                    faces[i] = j;
+
+            if(faces[i] < 0)
+                return false;
+        }
+
+        return true;
+#endif
     }
 
-    //convert tiles into corners
-    void Tiles::toCorner(std::string *corner, const std::string &cube) {
+    //the faces of the tiles, with the colors of the DBL corner
+    bool Tiles::toFaces(const char cube[], int8_t faces[]){
+        const char* opposite;
+        char colors[N_FACES];
         int8_t i;
 
-        for (i = 0; i < N_CORNERS; i++)
-            corner[i] = "";
+        //the colors of D, L, B and their opposites, with colors or with faces
+        colors[3] = COLOR_TABLES.lower[(uint8_t)cube[D_BL]];
+        colors[4] = COLOR_TABLES.lower[(uint8_t)cube[L_DB]];
+        colors[5] = COLOR_TABLES.lower[(uint8_t)cube[B_DL]];
+
+        opposite = COLOR_TABLES.opposite[colors[4] == LEFT];
 
-        for (i = 0; i < N_TILES; i++)
-            corner[i / 3].append(1, (char) std::tolower(cube.at(C_ORDER[i])));
+        for(i = 3; i < N_FACES; i++)
+            colors[OPPOSITE[i]] = opposite[(uint8_t)colors[i]];
+
+        //the DBL corner must have three colors of different faces
+        if(colors[0] == 0 || colors[1] == 0 || colors[2] == 0 || colors[3] == colors[4] || colors[3] == colors[5]
+                || colors[4] == colors[5] || colors[0] == colors[4] || colors[0] == colors[5] || colors[1] == colors[5])
+            return false;
+
+        return classify(cube, colors, faces);
+    }
+
+    //check the corners of the faces
+    Error Tiles::fromFaces(const int8_t faces[], uint16_t& ori, uint16_t& perm){
+        int8_t count[N_FACES]{};
+        int8_t twist[N_CORNERS], corner[N_CORNERS];
+        int8_t i, sum = 0;
+        int16_t key;
+        uint8_t seen = 0;
+        bool valid = true;
+
+        //every corner with a table, without branches
+        for(i = 0; i < N_CORNERS; i++){
+            key = (int16_t)((faces[C_ORDER[i*C_STATES]]*N_FACES + faces[C_ORDER[i*C_STATES + 1]])*N_FACES + faces[C_ORDER[i*C_STATES + 2]]);
+            corner[i] = CORNER_KEYS.corner[key];
+            twist[i] = CORNER_KEYS.twist[key];
+
+            valid &= corner[i] >= 0;
+            seen |= (uint8_t)(1 << (corner[i] & 7));
+            sum += twist[i];
+        }
+
+        //right corners have 4 tiles of every face, so the count is needed only for the errors
+        if(!valid || seen != 0xFF){
+            for(i = 0; i < N_TILES; i++)
+                count[faces[i]]++;
+
+            for(i = 0; i < N_FACES; i++)
+                if(count[i] != N_TILES_FACE)
+                    return ERR_COLOR;
+
+            return valid ? ERR_DUPLICATE : ERR_CORNER;
+        }
+
+        if(sum % C_STATES != 0)
+            return ERR_TWIST;
+
+        ori = Coords::comCOri(twist);
+        perm = Coords::compCPerm(corner);
+
+        return NO_ERROR;
     }
 
-    //convert to standard tiles
-    std::string Tiles::stdTiles(const std::string &cube) {
-        char faces[N_FACES];
-        std::string newCube(cube);
-        uint8_t i;
+    //check the tiles
+    Error Tiles::validate(const char cube[], uint16_t& ori, uint16_t& perm){
+        int8_t faces[N_TILES];
+
+        if(!toFaces(cube, faces))
+            return ERR_COLOR;
 
-        std::for_each(newCube.begin(), newCube.end(), [](char &c) {
-            c = (char) std::tolower(c);
-        });
+        return fromFaces(faces, ori, perm);
+    }
 
-        faces[1] = newCube.at(L_DB);
-        faces[3] = newCube.at(D_BL);
-        faces[5] = newCube.at(B_DL);
+    //pack 8 faces of 3 bits, the bytes are joined in pairs, then in fours, then all
+    static uint32_t pack8(const int8_t faces[]){
+        uint64_t x;
 
-        for (i = 0; i < N_FACES; i++) {
-            if (i % 2 == 0)
-                faces[i] = INV_COLOR[1][std::string(INV_COLOR[0]).find(faces[i + 1])];
+        memcpy(&x, faces, sizeof(x));
 
-            std::replace(newCube.begin(), newCube.end(), faces[i], FACES[i]);
+        x = (x & 0x00FF00FF00FF00FFull) | ((x & 0xFF00FF00FF00FF00ull) >> 5);
+        x = (x & 0x0000FFFF0000FFFFull) | ((x & 0xFFFF0000FFFF0000ull) >> 10);
+
+        return (uint32_t)((x & 0xFFFFFFFFull) | (x >> 32 << 12));
+    }
+
+    //unpack 8 faces of 3 bits, the inverse of pack8
+    static void unpack8(uint32_t bits, int8_t faces[]){
+        uint64_t x = bits;
+
+        x = (x & 0xFFFull) | ((x & 0xFFF000ull) << 20);
+        x = (x & 0x0000003F0000003Full) | ((x & 0x00000FC000000FC0ull) << 10);
+        x = (x & 0x0007000700070007ull) | ((x & 0x0038003800380038ull) << 5);
+
+        memcpy(faces, &x, sizeof(x));
+    }
+
+    //3 bits for every face, 8 faces in 3 bytes
+    void Tiles::pack(const int8_t faces[], uint8_t packed[]){
+        uint32_t bits;
+        int8_t i;
+
+        for(i = 0; i < N_TILES / 8; i++){
+            bits = pack8(faces + i*8);
+
+            packed[i*3] = (uint8_t)bits;
+            packed[i*3 + 1] = (uint8_t)(bits >> 8);
+            packed[i*3 + 2] = (uint8_t)(bits >> 16);
         }
+    }
 
-        for (i = 0; i < N_FACES; i++) {
-            if (std::count(newCube.begin(), newCube.end(), FACES[i]) != N_TILES_FACE) {
-                error = ERR_COLOR;
-                return "";
-            }
+    //the faces of 3 bytes at time, 6 and 7 are not faces
+    bool Tiles::unpack(const uint8_t packed[], int8_t faces[]){
+        uint64_t x, bad = 0;
+        int8_t i;
+
+        for(i = 0; i < N_TILES / 8; i++){
+            unpack8((uint32_t)packed[i*3] | (uint32_t)packed[i*3 + 1] << 8 | (uint32_t)packed[i*3 + 2] << 16, faces + i*8);
+
+            //a face of 6 or 7 has the bits of 4 and 2
+            memcpy(&x, faces + i*8, sizeof(x));
+            bad |= x & (x << 1) & 0x0404040404040404ull;
         }
 
-        return newCube;
+        return bad == 0;
+    }
+
+    //the colors of the faces
+    void Tiles::toColors(const int8_t faces[], char cube[]){
+        int8_t i;
+
+        for(i = 0; i < N_TILES; i++)
+            cube[i] = FACE_COLORS[1][faces[i]];
     }
 
     //rotate 4 tiles
@@ -271,9 +417,120 @@ namespace Solver2x2 {
         tilesU3
     };
 
+    //the permutations of the moves, the new tile i is the old tile perm[i]
+    struct TilePerms{
+        uint8_t perm[N_MOVES][N_TILES];
+
+        TilePerms(){
+            char tiles[N_TILES];
+            int8_t move, i;
+
+            for(move = 0; move < N_MOVES; move++){
+                for(i = 0; i < N_TILES; i++)
+                    tiles[i] = (char)i;
+
+                moveTileF[move](tiles);
+
+                for(i = 0; i < N_TILES; i++)
+                    perm[move][i] = (uint8_t)tiles[i];
+            }
+        }
+    };
+
+    //built with the moves above at the start
+    static const TilePerms TILE_PERMS;
+
+#ifdef SIMD_X86
+    //shuffle the 24 bytes in two registers, every half reads from both the halves
+    __attribute__((target("ssse3")))
+    static void shuffleSsse3(uint8_t data[], const uint8_t perm[]){
+        const __m128i lo = _mm_loadu_si128((const __m128i*)data);
+        const __m128i hi = _mm_loadl_epi64((const __m128i*)(data + 16));
+        const __m128i low = _mm_set1_epi8(0x70), high = _mm_set1_epi8(16);
+        __m128i idx, res;
+
+        //an index over 15 gets the high bit with the add, so it reads zero from lo
+        idx = _mm_loadu_si128((const __m128i*)perm);
+        res = _mm_or_si128(_mm_shuffle_epi8(lo, _mm_adds_epu8(idx, low)), _mm_shuffle_epi8(hi, _mm_sub_epi8(idx, high)));
+        idx = _mm_loadl_epi64((const __m128i*)(perm + 16));
+        idx = _mm_or_si128(_mm_shuffle_epi8(lo, _mm_adds_epu8(idx, low)), _mm_shuffle_epi8(hi, _mm_sub_epi8(idx, high)));
+
+        _mm_storeu_si128((__m128i*)data, res);
+        _mm_storel_epi64((__m128i*)(data + 16), idx);
+    }
+#endif
+
+#ifdef SIMD_NEON
+    //shuffle the 24 bytes with a table of two registers
+    static void shuffleNeon(uint8_t data[], const uint8_t perm[]){
+        uint8x16x2_t table = {{vld1q_u8(data), vcombine_u8(vld1_u8(data + 16), vdup_n_u8(0))}};
+        uint8x16_t res;
+
+        res = vqtbl2q_u8(table, vld1q_u8(perm));
+        vst1_u8(data + 16, vget_low_u8(vqtbl2q_u8(table, vcombine_u8(vld1_u8(perm + 16), vdup_n_u8(0)))));
+        vst1q_u8(data, res);
+    }
+#endif
+
+    //shuffle the 24 bytes, a byte at time
+    static void shuffleScalar(uint8_t data[], const uint8_t perm[]){
+        uint8_t tmp[N_TILES];
+        int8_t i;
+
+        for(i = 0; i < N_TILES; i++)
+            tmp[i] = data[perm[i]];
+
+        memcpy(data, tmp, N_TILES);
+    }
+
+    //choose the shuffle of the cpu
+    static shuffle_f chooseShuffle(){
+#if defined(SIMD_X86)
+        if(hasSsse3())
+            return shuffleSsse3;
+#elif defined(SIMD_NEON)
+        return shuffleNeon;
+#endif
+        return shuffleScalar;
+    }
+
+    //the shuffle used by the moves
+    static const shuffle_f shuffle = chooseShuffle();
+
     //move tiles char
     void Tiles::moveTiles(char tiles[], int8_t move){
-        moveTileF[move](tiles);
+        shuffle(reinterpret_cast<uint8_t*>(tiles), TILE_PERMS.perm[move]);
+    }
+
+    //multiply the moves
+    void Tiles::sequencePerm(uint8_t perm[], const int8_t moves[], size_t n){
+        size_t i;
+
+        for(i = 0; i < N_TILES; i++)
+            perm[i] = (uint8_t)i;
+
+        //moving the permutation gives perm[i] = old perm[move perm[i]]
+        for(i = 0; i < n; i++)
+            shuffle(perm, TILE_PERMS.perm[moves[i]]);
+    }
+
+    //apply a permutation
+    void Tiles::applyPerm(char tiles[], const uint8_t perm[]){
+        shuffle(reinterpret_cast<uint8_t*>(tiles), perm);
+    }
+
+    //coordinates to tiles
+    void Tiles::toTiles(char tiles[], uint16_t ori, uint16_t perm){
+        int8_t o[N_CORNERS], p[N_CORNERS];
+        int8_t i, n;
+
+        Coords::invCOri(o, ori);
+        Coords::invCPerm(p, perm);
+
+        for(i = 0; i < N_CORNERS; i++)
+            for(n = 0; n < C_STATES; n++)
+                tiles[C_ORDER[i*C_STATES + (n+o[i])%C_STATES]] =
+                        FACE_COLORS[1][strchr(FACE_COLORS[0], CORNER_FACES[p[i]][n]) - FACE_COLORS[0]];
     }
 
     //tests the tiles
@@ -293,6 +550,74 @@ namespace Solver2x2 {
 
             assert(memcmp(cube, SOL_CUBE, N_TILES) == 0);
         }
+
+        //the sequence in a permutation is the same of the moves
+        for(int8_t i = 0; i < N_MOVES; i++){
+            const int8_t seq[] = {i, (int8_t)((i+4)%N_MOVES), (int8_t)((i+7)%N_MOVES), 0, 8};
+            char moved[N_TILES];
+            uint8_t perm[N_TILES];
+
+            memcpy(cube, SOL_CUBE, N_TILES);
+            memcpy(moved, SOL_CUBE, N_TILES);
+
+            for(int8_t move : seq)
+                moveTileF[move](moved);
+
+            sequencePerm(perm, seq, sizeof(seq));
+            applyPerm(cube, perm);
+
+            assert(memcmp(cube, moved, N_TILES) == 0);
+        }
+
+        cube[N_TILES] = '\0';
+
+        for(int32_t i = 0; i < ORI_CASES*PERM_CASES; i+=97){
+            toTiles(cube, (uint16_t)(i/PERM_CASES), (uint16_t)(i%PERM_CASES));
+            Tiles tiles(cube);
+            assert(tiles.getOri() == i/PERM_CASES && tiles.getPerm() == i%PERM_CASES);
+        }
+
+        //the faces packed in 3 bits
+        for(int8_t i = 0; i < N_MOVES; i++){
+            int8_t faces[N_TILES], unpacked[N_TILES];
+            uint8_t packed[PACKED_BYTES];
+            bool valid;
+
+            memcpy(cube, SOL_CUBE, N_TILES);
+            moveTiles(cube, i);
+            moveTiles(cube, (int8_t)((i+4)%N_MOVES));
+
+            valid = toFaces(cube, faces);
+            pack(faces, packed);
+            valid = valid && unpack(packed, unpacked);
+            assert(valid && memcmp(faces, unpacked, N_TILES) == 0);
+
+            packed[i] = 0xFF;
+            valid = unpack(packed, unpacked);
+            assert(!valid);
+            (void)valid;
+        }
+
+        //the faces instead of the colors
+        assert(Tiles("UUUURRRRFFFFDDDDLLLLBBBB").getError() == NO_ERROR);
+        assert(Tiles("UUUURRRRFFFFDDDDLLLLBBBX").getError() == ERR_COLOR);
+
+        //a twisted corner
+        memcpy(cube, SOL_CUBE, N_TILES);
+        std::swap(cube[U_FR], cube[R_FU]);
+        std::swap(cube[U_FR], cube[F_UR]);
+        assert(Tiles(cube).getError() == ERR_TWIST);
+
+        //a corner that does not exist
+        memcpy(cube, SOL_CUBE, N_TILES);
+        std::swap(cube[U_FR], cube[R_FU]);
+        assert(Tiles(cube).getError() == ERR_CORNER);
+
+        //URF instead of UFL and DBL instead of DRB, the colors are right
+        memcpy(cube, SOL_CUBE, N_TILES);
+        cube[U_FL] = cube[U_FR]; cube[F_UL] = cube[R_FU]; cube[L_FU] = cube[F_UR];
+        cube[D_BR] = cube[D_BL]; cube[R_BD] = cube[B_DL]; cube[B_DR] = cube[L_DB];
+        assert(Tiles(cube).getError() == ERR_DUPLICATE);
     }
 
 }
\ No newline at end of file
@@ -24,6 +24,7 @@
 
 #include <string>
 #include "Coords.h"
+#include "Solver2x2.h"
 
 /**
  * The total number of tiles in the cube.
@@ -74,6 +75,9 @@ namespace Solver2x2{
         NO_ERROR = 0,
         FEW_TILES = 1,
         ERR_COLOR = 2,
+        ERR_CORNER = 3,
+        ERR_DUPLICATE = 4,
+        ERR_TWIST = 5
     };
 
     /**
@@ -114,6 +118,29 @@ namespace Solver2x2{
             "bdr"
     };
 
+    /**
+     * The faces of the corners, with the tiles in the order of C_ORDER.
+     * The first face is the U or D face.
+     */
+    constexpr char CORNER_FACES[N_CORNERS][4] = {
+            "urf",
+            "ufl",
+            "ulb",
+            "ubr",
+            "dfr",
+            "dlf",
+            "dbl",
+            "drb"
+    };
+
+    /**
+     * The faces and their colors in the solved cube.
+     */
+    constexpr char FACE_COLORS[2][N_FACES+1] = {
+            "urfdlb",
+            "YOGWRB"
+    };
+
     /**
      * Class Tiles
      * This class is used to convert the cube tiles
@@ -176,41 +203,66 @@ namespace Solver2x2{
          */
         uint16_t getOri() const;
 
-    private:
+    public:
 
         /**
-         * Convert the corners tiles into permutation coordinate.
+         * Check all the tiles and convert them into coordinates, without strings.
+         * The colors are classified with SIMD, then every corner must have the
+         * colors of a real corner in the right order, every corner must be
+         * there once and the sum of the twists must be a multiple of 3.
          *
-         * @param c     : The corners.
-         * @return      : The permutation coordinate.
+         * @param cube      : The tiles, of N_TILES chars.
+         * @param ori       : The corner orientation found.
+         * @param perm      : The corner permutation found.
+         * @return          : The error, NO_ERROR if the cube is right.
          */
-        static uint16_t toPerm(std::string c[N_CORNERS]);
+        static Error validate(const char cube[], uint16_t& ori, uint16_t& perm);
 
         /**
-         * Convert the corners tiles into orientation coordinate.
+         * Convert the colors of the tiles into faces, from 0 to 5 in the order of FACE_COLORS.
+         * The faces are given by the DBL corner.
          *
-         * @param c     : The corners.
-         * @return      : The orientation coordinate.
+         * @param cube      : The tiles, of N_TILES chars.
+         * @param faces     : The array to store the faces, of N_TILES.
+         * @return          : False if a tile has not the color of a face.
          */
-        static uint16_t toOrient(std::string c[N_CORNERS]);
+        static bool toFaces(const char cube[], int8_t faces[]);
 
         /**
-         * Convert the cube tiles into corners.
+         * Check the corners of the faces and convert them into coordinates.
          *
-         * @param corner    : The array of corner to store them.
-         * @param cube      : The cube tiles string.
+         * @param faces     : The faces of the tiles, from 0 to 5.
+         * @param ori       : The corner orientation found.
+         * @param perm      : The corner permutation found.
+         * @return          : The error, NO_ERROR if the cube is right.
          */
-        static void toCorner(std::string corner[N_CORNERS], const std::string& cube);
+        static Error fromFaces(const int8_t faces[], uint16_t& ori, uint16_t& perm);
 
         /**
-         * Convert color tiles into standard tiles.
+         * Convert the faces into the colors of the solved cube, in FACE_COLORS.
          *
-         * @param cube      : The cube tiles string.
-         * @return          : The new cube with no colors.
+         * @param faces     : The faces of the tiles, from 0 to 5.
+         * @param cube      : The array to store the tiles, of N_TILES chars.
          */
-        std::string stdTiles(const std::string& cube);
+        static void toColors(const int8_t faces[], char cube[]);
 
-    public:
+        /**
+         * Pack the faces in 3 bits each, the tile i in the bits from 3*i
+         * of the PACKED_BYTES bytes, the first byte has the lowest bits.
+         *
+         * @param faces     : The faces of the tiles, from 0 to 5.
+         * @param packed    : The array to store the packed cube, of PACKED_BYTES.
+         */
+        static void pack(const int8_t faces[], uint8_t packed[]);
+
+        /**
+         * Unpack the faces of a packed cube.
+         *
+         * @param packed    : The packed cube, of PACKED_BYTES.
+         * @param faces     : The array to store the faces, of N_TILES.
+         * @return          : False if a value is not a face.
+         */
+        static bool unpack(const uint8_t packed[], int8_t faces[]);
 
         /**
          * It moves the tiles in base of a move.
@@ -218,6 +270,35 @@ namespace Solver2x2{
          */
         static void moveTiles(char tiles[], int8_t move);
 
+        /**
+         * Multiply a sequence of moves into a single permutation of the tiles.
+         * After the permutation the tile i is the old tile perm[i].
+         *
+         * @param perm      : The array to store the permutation, of N_TILES bytes.
+         * @param moves     : The moves.
+         * @param n         : The number of moves.
+         */
+        static void sequencePerm(uint8_t perm[], const int8_t moves[], size_t n);
+
+        /**
+         * Apply a permutation of the tiles, like a sequence of moves
+         * in a single shuffle.
+         *
+         * @param tiles     : The tiles to move, of N_TILES chars.
+         * @param perm      : The permutation, of N_TILES bytes.
+         */
+        static void applyPerm(char tiles[], const uint8_t perm[]);
+
+        /**
+         * Convert the coordinates into the colors of the tiles.
+         * The DBL corner is kept still, like in the solver.
+         *
+         * @param tiles     : The array to store the tiles, of N_TILES chars.
+         * @param ori       : Corner orientation.
+         * @param perm      : Corner permutation.
+         */
+        static void toTiles(char tiles[], uint16_t ori, uint16_t perm);
+
         /**
          * Tests the tiles.
          */
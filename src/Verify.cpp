@@ -0,0 +1,95 @@
+/**
+ * This file contains the class Verify.
+ * It checks all the solutions of a table applying the moves
+ * on the coordinates, in more threads.
+ */
+
+#include <thread>
+#include <vector>
+#include "Verify.h"
+
+namespace Solver2x2{
+
+    //set the table
+    Verify::Verify(TableBackend* backend, Coords& coords) : backend(backend), coords(coords){}
+
+    //check all the cubes
+    uint32_t Verify::check(uint32_t threads){
+        std::vector<std::thread> workers;
+        std::vector<uint32_t> wrong(threads, 0);
+        uint32_t t, size, res = 0;
+
+        if(threads == 0)
+            return CUBE_CASES;
+
+        size = (CUBE_CASES + threads - 1) / threads;
+
+        for(t = 0; t < threads; t++)
+            workers.emplace_back(&Verify::checkRange, this, std::min(t*size, (uint32_t)CUBE_CASES),
+                                 std::min((t+1)*size, (uint32_t)CUBE_CASES), std::ref(wrong[t]));
+
+        for(t = 0; t < threads; t++){
+            workers[t].join();
+            res += wrong[t];
+        }
+
+        return res;
+    }
+
+    //check a range
+    void Verify::checkRange(uint32_t begin, uint32_t end, uint32_t& wrong){
+        uint32_t i, count = 0;
+
+        for(i = begin; i < end; i++)
+            if(!checkCube(i))
+                count++;
+
+        wrong = count;
+    }
+
+    //check a cube
+    bool Verify::checkCube(uint32_t idx){
+        uint16_t ori = (uint16_t)(idx / PERM_CASES), perm = (uint16_t)(idx % PERM_CASES);
+        uint64_t moves = backend->solve(ori, perm);
+        uint32_t next[N_MOVES + MAX_DEPTH];
+        int8_t depths[N_MOVES + MAX_DEPTH];
+        int8_t depth = Explore::Scramble::depth(moves), move, i;
+
+        //only the solved cube has no moves, and after the moves there is nothing
+        if(depth >= MAX_DEPTH || (depth == 0) != (idx == 0) || (moves >> (4*(depth+1))) != 0)
+            return false;
+
+        //the cubes after every move and after the moves of the solution, read in a batch
+        for(move = 0; move < N_MOVES; move++)
+            next[move] = Explore::Scramble::index(coords.moveCOri(ori, move), coords.moveCPerm(perm, move));
+
+        for(i = 0; i < depth; i++){
+            moves >>= 4;
+            move = (int8_t)(moves & 0xF);
+
+            if(move >= N_MOVES)
+                return false;
+
+            ori = coords.moveCOri(ori, move);
+            perm = coords.moveCPerm(perm, move);
+            next[N_MOVES + i] = Explore::Scramble::index(ori, perm);
+        }
+
+        if(ori != 0 || perm != 0)
+            return false;
+
+        backend->depth(next, depths, (uint32_t)(N_MOVES + depth));
+
+        //the moves of the cube change the depth at most by one
+        for(move = 0; move < N_MOVES; move++)
+            if(depths[move] < depth - 1 || depths[move] > depth + 1)
+                return false;
+
+        //every move of the solution lowers the depth by one
+        for(i = 0; i < depth; i++)
+            if(depths[N_MOVES + i] != depth - 1 - i)
+                return false;
+
+        return true;
+    }
+}
@@ -0,0 +1,70 @@
+/**
+ * This file contains the class Verify.
+ * It checks all the solutions of a table applying the moves
+ * on the coordinates, in more threads. The solutions and the
+ * depths are read from the table used by the solves, so the
+ * small tables and the files read are checked as they are.
+ */
+
+#ifndef SOLVER2X2_CXX_VERIFY_H
+#define SOLVER2X2_CXX_VERIFY_H
+
+#include "Explore.h"
+#include "Backend.h"
+
+namespace Solver2x2{
+
+    /**
+     * Class Verify
+     * A solution is right if its moves reach the solved cube, every
+     * move lowers the depth by one and every move of the cube changes
+     * the depth at most by one. The last check, with the solved cube
+     * the only one of depth 0, makes every depth the shortest one.
+     */
+    class Verify{
+    private:
+
+        ///the table to check
+        TableBackend* backend;
+
+        ///the coords to move the cubes
+        Coords& coords;
+
+        /**
+         * Check a range of cubes.
+         *
+         * @param begin     : The first index.
+         * @param end       : The index after the last one.
+         * @param wrong     : The number of wrong cubes found.
+         */
+        void checkRange(uint32_t begin, uint32_t end, uint32_t& wrong);
+
+        /**
+         * Check a cube.
+         *
+         * @param idx       : The index of the cube.
+         * @return          : True if its solution is right.
+         */
+        bool checkCube(uint32_t idx);
+
+    public:
+
+        /**
+         * Set the table to check.
+         *
+         * @param backend   : The table.
+         * @param coords    : The coords to move the cubes.
+         */
+        Verify(TableBackend* backend, Coords& coords);
+
+        /**
+         * Check all the cubes.
+         *
+         * @param threads   : The number of threads.
+         * @return          : The number of wrong cubes.
+         */
+        uint32_t check(uint32_t threads);
+    };
+}
+
+#endif //SOLVER2X2_CXX_VERIFY_H
@@ -16,7 +16,7 @@ namespace Solver2x2 {
     typedef void (*move_func)(int8_t c[]);
 
     //inverse move
-    static const int8_t invMoveArr[N_MOVES] = {
+    static const int8_t invMoveArr[N_FACE_MOVES] = {
         F3_MOVE,
         F2_MOVE,
         F1_MOVE,
@@ -25,11 +25,20 @@ namespace Solver2x2 {
         R1_MOVE,
         U3_MOVE,
         U2_MOVE,
-        U1_MOVE
+        U1_MOVE,
+        B3_MOVE,
+        B2_MOVE,
+        B1_MOVE,
+        L3_MOVE,
+        L2_MOVE,
+        L1_MOVE,
+        D3_MOVE,
+        D2_MOVE,
+        D1_MOVE
     };
 
     //move to a string
-    static const char moveToStrArr[N_MOVES][3]{
+    static const char moveToStrArr[N_FACE_MOVES][3]{
             "F1",
             "F2",
             "F3",
@@ -38,7 +47,16 @@ namespace Solver2x2 {
             "R3",
             "U1",
             "U2",
-            "U3"
+            "U3",
+            "B1",
+            "B2",
+            "B3",
+            "L1",
+            "L2",
+            "L3",
+            "D1",
+            "D2",
+            "D3"
     };
 
     //cube mover functions corner perm
@@ -136,6 +154,101 @@ namespace Solver2x2 {
         c[DFR] = tmp;
     }
 
+    //moves of the other faces, only for the whole corner group
+
+    static void moveB1Perm(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = c[UBR];
+        c[UBR] = c[DBR];
+        c[DBR] = c[DBL];
+        c[DBL] = tmp;
+    }
+
+    static void moveB2Perm(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = c[DBR];
+        c[DBR] = tmp;
+        tmp = c[UBR];
+        c[UBR] = c[DBL];
+        c[DBL] = tmp;
+    }
+
+    static void moveB3Perm(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = c[DBL];
+        c[DBL] = c[DBR];
+        c[DBR] = c[UBR];
+        c[UBR] = tmp;
+    }
+
+    static void moveL1Perm(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = c[DBL];
+        c[DBL] = c[DFL];
+        c[DFL] = c[UFL];
+        c[UFL] = tmp;
+    }
+
+    static void moveL2Perm(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = c[DFL];
+        c[DFL] = tmp;
+        tmp = c[DBL];
+        c[DBL] = c[UFL];
+        c[UFL] = tmp;
+    }
+
+    static void moveL3Perm(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = c[UFL];
+        c[UFL] = c[DFL];
+        c[DFL] = c[DBL];
+        c[DBL] = tmp;
+    }
+
+    static void moveD1Perm(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[DFL];
+        c[DFL] = c[DBL];
+        c[DBL] = c[DBR];
+        c[DBR] = c[DFR];
+        c[DFR] = tmp;
+    }
+
+    static void moveD2Perm(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[DFL];
+        c[DFL] = c[DBR];
+        c[DBR] = tmp;
+        tmp = c[DBL];
+        c[DBL] = c[DFR];
+        c[DFR] = tmp;
+    }
+
+    static void moveD3Perm(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[DFL];
+        c[DFL] = c[DFR];
+        c[DFR] = c[DBR];
+        c[DBR] = c[DBL];
+        c[DBL] = tmp;
+    }
+
     //cube mover functions Ori
 
     static void moveF1Ori(int8_t c[]){
@@ -231,8 +344,103 @@ namespace Solver2x2 {
         c[DFR] = (int8_t)((tmp + C_CLOCKWISE)%C_STATES);
     }
 
+    //moves of the other faces, only for the whole corner group
+
+    static void moveB1Ori(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = (int8_t)((c[UBR] + C_CLOCKWISE)%C_STATES);
+        c[UBR] = (int8_t)((c[DBR] + C_ANTICLOCKWISE)%C_STATES);
+        c[DBR] = (int8_t)((c[DBL] + C_CLOCKWISE)%C_STATES);
+        c[DBL] = (int8_t)((tmp + C_ANTICLOCKWISE)%C_STATES);
+    }
+
+    static void moveB2Ori(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = c[DBR];
+        c[DBR] = tmp;
+        tmp = c[UBR];
+        c[UBR] = c[DBL];
+        c[DBL] = tmp;
+    }
+
+    static void moveB3Ori(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = (int8_t)((c[DBL] + C_CLOCKWISE)%C_STATES);
+        c[DBL] = (int8_t)((c[DBR] + C_ANTICLOCKWISE)%C_STATES);
+        c[DBR] = (int8_t)((c[UBR] + C_CLOCKWISE)%C_STATES);
+        c[UBR] = (int8_t)((tmp + C_ANTICLOCKWISE)%C_STATES);
+    }
+
+    static void moveL1Ori(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = (int8_t)((c[DBL] + C_ANTICLOCKWISE)%C_STATES);
+        c[DBL] = (int8_t)((c[DFL] + C_CLOCKWISE)%C_STATES);
+        c[DFL] = (int8_t)((c[UFL] + C_ANTICLOCKWISE)%C_STATES);
+        c[UFL] = (int8_t)((tmp + C_CLOCKWISE)%C_STATES);
+    }
+
+    static void moveL2Ori(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = c[DFL];
+        c[DFL] = tmp;
+        tmp = c[DBL];
+        c[DBL] = c[UFL];
+        c[UFL] = tmp;
+    }
+
+    static void moveL3Ori(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[UBL];
+        c[UBL] = (int8_t)((c[UFL] + C_ANTICLOCKWISE)%C_STATES);
+        c[UFL] = (int8_t)((c[DFL] + C_CLOCKWISE)%C_STATES);
+        c[DFL] = (int8_t)((c[DBL] + C_ANTICLOCKWISE)%C_STATES);
+        c[DBL] = (int8_t)((tmp + C_CLOCKWISE)%C_STATES);
+    }
+
+    static void moveD1Ori(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[DFL];
+        c[DFL] = c[DBL];
+        c[DBL] = c[DBR];
+        c[DBR] = c[DFR];
+        c[DFR] = tmp;
+    }
+
+    static void moveD2Ori(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[DFL];
+        c[DFL] = c[DBR];
+        c[DBR] = tmp;
+        tmp = c[DBL];
+        c[DBL] = c[DFR];
+        c[DFR] = tmp;
+    }
+
+    static void moveD3Ori(int8_t c[]){
+        int8_t tmp;
+
+        tmp = c[DFL];
+        c[DFL] = c[DFR];
+        c[DFR] = c[DBR];
+        c[DBR] = c[DBL];
+        c[DBL] = tmp;
+    }
+
     //useful for not using switch case
-    const move_func oriFunc[N_MOVES] = {
+    const move_func oriFunc[N_FACE_MOVES] = {
             moveF1Ori,
             moveF2Ori,
             moveF3Ori,
@@ -241,8 +449,16 @@ namespace Solver2x2 {
             moveR3Ori,
             moveU1Ori,
             moveU2Ori,
-            moveU3Ori
-
+            moveU3Ori,
+            moveB1Ori,
+            moveB2Ori,
+            moveB3Ori,
+            moveL1Ori,
+            moveL2Ori,
+            moveL3Ori,
+            moveD1Ori,
+            moveD2Ori,
+            moveD3Ori
     };
 
     //move corner orientation
@@ -251,7 +467,7 @@ namespace Solver2x2 {
     }
 
     //useful for not using switch case
-    const move_func permFunc[N_MOVES] = {
+    const move_func permFunc[N_FACE_MOVES] = {
             moveF1Perm,
             moveF2Perm,
             moveF3Perm,
@@ -260,7 +476,16 @@ namespace Solver2x2 {
             moveR3Perm,
             moveU1Perm,
             moveU2Perm,
-            moveU3Perm
+            moveU3Perm,
+            moveB1Perm,
+            moveB2Perm,
+            moveB3Perm,
+            moveL1Perm,
+            moveL2Perm,
+            moveL3Perm,
+            moveD1Perm,
+            moveD2Perm,
+            moveD3Perm
     };
 
     //move corner perm;
@@ -285,11 +510,11 @@ namespace Solver2x2 {
         int8_t ori[N_CORNERS], perm[N_CORNERS];
         int8_t i, j;
 
-        for(i = 0; i < N_MOVES; i++){
+        for(i = 0; i < N_FACE_MOVES; i++){
             memcpy(ori, SOLVED_ORI, N_CORNERS);
             memcpy(perm, SOLVED_PERM, N_CORNERS);
 
-            for(j = 0; j < N_MOVES; j++){
+            for(j = 0; j < N_FACE_MOVES; j++){
                 moveOri(ori, j);
                 moveOri(ori, invMove(j));
 
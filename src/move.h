@@ -22,6 +22,12 @@ namespace Solver2x2 {
      */
     #define N_MOVES 9
 
+    /**
+     * Number of moves with all the faces, the 2x2 solver keeps
+     * DBL still and uses only the first N_MOVES.
+     */
+    #define N_FACE_MOVES 18
+
     /**
      * This is the number assigned to a corner in the correct orientation.
      */
@@ -58,7 +64,16 @@ namespace Solver2x2 {
         U1_MOVE = 6,
         U2_MOVE = 7,
         U3_MOVE = 8,
-        NO_MOVE = 9,
+        B1_MOVE = 9,
+        B2_MOVE = 10,
+        B3_MOVE = 11,
+        L1_MOVE = 12,
+        L2_MOVE = 13,
+        L3_MOVE = 14,
+        D1_MOVE = 15,
+        D2_MOVE = 16,
+        D3_MOVE = 17,
+        NO_MOVE = 18,
     };
 
     /**